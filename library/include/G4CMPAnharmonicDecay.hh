@@ -1,13 +1,17 @@
 /* Header File for AnharmonicDecay utility class */
 
 // 20221103  Drop G4CMP_DEBUG protection here, to avoid client rebuilding
+// 20261018  Sample daughter energy fractions from per-lattice tables
 
 #ifndef G4CMPAnharmonicDecay_h
 #define G4CMPAnharmonicDecay_h
 
 #include "G4CMPProcessUtils.hh"
+#include "G4CMPInverseCDFTable.hh"
 #include <iosfwd>
+#include <map>
 
+class G4LatticeLogical;
 class G4ParticleChange;
 class G4Step;
 class G4Track;
@@ -33,12 +37,26 @@ private:
   void MakeTTSecondaries(const G4Track&, G4ParticleChange&);
   void MakeLTSecondaries(const G4Track&, G4ParticleChange&);
 
+  // Inverse CDFs of energy fraction, filled on first decay in each lattice
+  struct DecayTables {
+    G4CMPInverseCDFTable tt;		// First T phonon in L->T+T
+    G4CMPInverseCDFTable lt;		// L' phonon in L->L'+T
+  };
+
+  struct TTShape;			// Densities used to fill tables
+  struct LTShape;
+
+  const DecayTables& GetDecayTables();
+
   G4int verboseLevel;			// For diagnostic output
   G4String procName;			// Process name for diagnostics
 
   G4double fBeta, fGamma, fLambda, fMu; // Local buffers for decay parameters
   G4double fvLvT; 			// Ratio of sound speeds
 
+  std::map<const G4LatticeLogical*, DecayTables> decayTables;
+  const DecayTables* fTables;		// Tables for current lattice
+
   std::ofstream output;			// Only used for G4CMP_DEBUG debugging
 };
 
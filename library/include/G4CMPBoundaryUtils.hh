@@ -19,6 +19,8 @@
 // 20170713  Add registry to keep track of missing-surface warnings
 // 20171215  Change 'CheckStepStatus()' to 'IsBoundaryStep()', add function
 //	     to validate step trajectory to boundary.
+// 20261018  Add typed surface data pointer alongside matTable
+// 20261018  Registry now records only boundaries without surfaces
 
 #ifndef G4CMPBoundaryUtils_hh
 #define G4CMPBoundaryUtils_hh 1
@@ -29,6 +31,7 @@
 #include <utility>
 
 class G4CMPProcessUtils;
+struct G4CMPSurfaceData;
 class G4CMPSurfaceProperty;
 class G4CMPVElectrodePattern;
 class G4MaterialPropertiesTable;
@@ -100,9 +103,10 @@ protected:
   G4VPhysicalVolume* postPV;
   G4CMPSurfaceProperty* surfProp;	// Surface property with G4CMP data
   G4MaterialPropertiesTable* matTable;	// Phonon- or charge-specific parameters
+  const G4CMPSurfaceData* surfData;	// Same parameters, without lookups
   G4CMPVElectrodePattern* electrode;	// Patterned electrode for absorption
 
-  // Flag whether a given PV pair has a defined surface property or not
+  // PV pairs already reported as having no surface defined
   typedef std::pair<G4VPhysicalVolume*,G4VPhysicalVolume*> BoundaryPV;
   std::map<BoundaryPV, G4bool> hasSurface;
 };
@@ -18,6 +18,7 @@
 //
 // 20170925  Add direct access to individual positions in cloud, binning
 // 20180831  Fix compiler warning on GetPositionBin()
+// 20261018  Generate points in batch, with analytic G4Box/G4Tubs folding
 
 #ifndef G4CMPChargeCloud_hh
 #define G4CMPChargeCloud_hh 1
@@ -55,7 +56,7 @@ public:
   const G4VTouchable* GetTouchable() const { return theTouchable; }
 
   void UseVolume(const G4VPhysicalVolume* vol);
-  void SetShape(const G4VSolid* solid) { theSolid = solid; }
+  void SetShape(const G4VSolid* solid);
   const G4VSolid* GetShape() const { return theSolid; }
 
   // Fill list of positions around specified center, within optional volume
@@ -79,6 +80,9 @@ public:
   // Generate point randomly in sphere of given radius
   virtual G4ThreeVector GeneratePoint(G4double rmax) const;
 
+  // Generate all points (local coordinates) in one pass, as used by Generate()
+  virtual void GeneratePoints(G4int npos, G4double rmax);
+
   // Adjust specified point to be inside volume
   void AdjustToVolume(G4ThreeVector& point) const;
 
@@ -94,6 +98,21 @@ protected:
   // Convert local position to bin index (pass-by-value for use as temporary)
   G4int GetBinIndex(G4ThreeVector localPos) const;
 
+  // Shapes with analytic inside test and folding; others use G4VSolid calls
+  enum ShapeType { kNoShape, kGenericShape, kBoxShape, kTubsShape };
+  void CacheShape();
+  void FoldToShape();			// Apply to all points in pointX/Y/Z
+
+  ShapeType shapeType;			// Set by SetShape()
+  G4double halfX, halfY, halfZ;		// G4Box half-lengths, or G4Tubs dz
+  G4double innerR, outerR;		// G4Tubs radii (full phi only)
+  G4double halfTolerance;		// Surface tolerance, as for Inside()
+
+  std::vector<G4double> pointX;		// Generated points as arrays, local
+  std::vector<G4double> pointY;
+  std::vector<G4double> pointZ;
+  std::vector<G4double> randoms;	// Buffer for batched random numbers
+
 private:
   std::vector<G4ThreeVector> theCloud;	// Buffer to carry generated points
   G4double cloudRadius;			// Radius used to generate distribution
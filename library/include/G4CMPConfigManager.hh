@@ -44,6 +44,10 @@
 // 20210303  G4CMP-243:  Add parameter to set step length for merging hits
 // 20210910  G4CMP-272:  Add parameter to set number of downsampled Luke phonons
 // 20220921  G4CMP-319:  Add temperature setting for use with QP sensors.
+// 20261018  Add flag to select uniformization for charge carrier steps
+// 20261018  Add flag and cache directory for KaplanQP response library
+// 20261018  Add flags to enable phonon scattering and decay separately
+// 20261018  Add energy window scale for uniformization majorant
 
 #include "globals.hh"
 #include <iosfwd>
@@ -72,6 +76,10 @@ public:
   static G4int GetMaxPhononBounces()	 { return Instance()->pBounces; }
   static G4int GetMaxLukePhonons()       { return Instance()->maxLukePhonons; }
   static G4bool UseKVSolver()            { return Instance()->useKVsolver; }
+  static G4bool UseUniformization()      { return Instance()->uniformize; }
+  static G4bool UseKaplanLibrary()       { return Instance()->kaplanLibrary; }
+  static G4bool PhononScatteringEnabled() { return Instance()->phononScatter; }
+  static G4bool PhononDecayEnabled()     { return Instance()->phononDecay; }
   static G4bool FanoStatisticsEnabled()  { return Instance()->fanoEnabled; }
   static G4bool CreateChargeCloud()      { return Instance()->chargeCloud; }
   static G4double GetSurfaceClearance()  { return Instance()->clearance; }
@@ -83,6 +91,7 @@ public:
   static G4double GetGenCharges()        { return Instance()->genCharges; }
   static G4double GetLukeSampling()      { return Instance()->lukeSample; }
   static G4double GetComboStepLength()   { return Instance()->combineSteps; }
+  static G4double GetMajorantScale()     { return Instance()->majorantScale; }
   static G4double GetETrappingMFP()      { return Instance()->eTrapMFP; }
   static G4double GetHTrappingMFP()      { return Instance()->hTrapMFP; }
   static G4double GetEDTrapIonMFP()      { return Instance()->eDTrapIonMFP; }
@@ -93,6 +102,7 @@ public:
 
   static const G4String& GetLatticeDir() { return Instance()->LatticeDir; }
   static const G4String& GetIVRateModel() { return Instance()->IVRateModel; }
+  static const G4String& GetKaplanCacheDir() { return Instance()->kaplanCache; }
 
   static const G4VNIELPartition* GetNIELPartition() { return Instance()->nielPartition; }
 
@@ -110,7 +120,13 @@ public:
   static void SetGenCharges(G4double value) { Instance()->genCharges = value; }
   static void SetLukeSampling(G4double value) { Instance()->lukeSample = value; }
   static void SetComboStepLength(G4double value) { Instance()->combineSteps = value; }
+  static void SetMajorantScale(G4double value) { Instance()->majorantScale = value; }
   static void UseKVSolver(G4bool value) { Instance()->useKVsolver = value; }
+  static void UseUniformization(G4bool value) { Instance()->uniformize = value; }
+  static void UseKaplanLibrary(G4bool value) { Instance()->kaplanLibrary = value; }
+  static void SetKaplanCacheDir(const G4String& dir) { Instance()->kaplanCache = dir; }
+  static void EnablePhononScattering(G4bool value) { Instance()->phononScatter = value; }
+  static void EnablePhononDecay(G4bool value) { Instance()->phononDecay = value; }
   static void EnableFanoStatistics(G4bool value) { Instance()->fanoEnabled = value; }
   static void SetIVRateModel(G4String value) { Instance()->IVRateModel = value; }
   static void CreateChargeCloud(G4bool value) { Instance()->chargeCloud = value; }
@@ -161,6 +177,7 @@ private:
   G4String version;	// Version name string extracted from .g4cmp-version
   G4String LatticeDir;	// Lattice data directory ($G4LATTICEDATA)
   G4String IVRateModel;	// Model for IV rate ($G4CMP_IV_RATE_MODEL)
+  G4String kaplanCache;	// Directory for KaplanQP libraries ($G4CMP_KAPLAN_CACHE)
   G4double eTrapMFP;	// Mean free path for electron trapping
   G4double hTrapMFP;	// Mean free path for hole trapping
   G4double eDTrapIonMFP; // Mean free path for e- on e-trap ionization ($G4CMP_EETRAPION_MFP)
@@ -175,9 +192,14 @@ private:
   G4double genCharges;	 // Rate to create primary e/h pairs ($G4CMP_MAKE_CHARGES)
   G4double lukeSample;   // Rate to create Luke phonons ($G4CMP_LUKE_SAMPLE)
   G4double combineSteps; // Maximum length to merge track steps ($G4CMP_COMBINE_STEPLEN)
+  G4double majorantScale; // Energy window for uniformization ($G4CMP_MAJORANT_SCALE)
   G4double EminPhonons;	 // Minimum energy to track phonons ($G4CMP_EMIN_PHONONS)
   G4double EminCharges;	 // Minimum energy to track e/h ($G4CMP_EMIN_CHARGES)
   G4bool useKVsolver;	 // Use K-Vg eigensolver ($G4CMP_USE_KVSOLVER)
+  G4bool uniformize;	 // Charge steps by majorant rate ($G4CMP_UNIFORMIZATION)
+  G4bool kaplanLibrary;	 // Sample film response from library ($G4CMP_KAPLAN_LIBRARY)
+  G4bool phononScatter;	 // Isotope scattering of phonons ($G4CMP_PHONON_SCATTERING)
+  G4bool phononDecay;	 // Anharmonic decay of phonons ($G4CMP_PHONON_DECAY)
   G4bool fanoEnabled;	 // Apply Fano statistics to ionization energy deposits ($G4CMP_FANO_ENABLED)
   G4bool chargeCloud;    // Produce e/h pairs around position ($G4CMP_CHARGE_CLOUD) 
 
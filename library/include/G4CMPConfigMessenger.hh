@@ -41,6 +41,10 @@
 // 20210303  G4CMP-243:  Add parameter to set step length for merging hits
 // 20210910  G4CMP-272:  Add parameter for soft maximum Luke phonons per event
 // 20220921  G4CMP-319:  Add temperature setting for use with QP sensors.
+// 20261018  Add command to select uniformization for charge steps
+// 20261018  Add commands for KaplanQP response library and cache
+// 20261018  Add commands to enable phonon scattering and decay separately
+// 20261018  Add command for uniformization majorant energy window
 
 #include "G4UImessenger.hh"
 
@@ -89,7 +93,13 @@ private:
   G4UIcmdWithAString* dirCmd;
   G4UIcmdWithAString* ivRateModelCmd;
   G4UIcmdWithAString* nielPartitionCmd;
+  G4UIcmdWithAString* kaplanCacheCmd;
   G4UIcmdWithABool*   kvmapCmd;
+  G4UIcmdWithABool*   uniformCmd;
+  G4UIcmdWithADouble* majorantCmd;
+  G4UIcmdWithABool*   kaplanLibCmd;
+  G4UIcmdWithABool*   phonScatCmd;
+  G4UIcmdWithABool*   phonDecayCmd;
   G4UIcmdWithABool*   fanoStatsCmd;
   G4UIcmdWithABool*   ehCloudCmd;
 
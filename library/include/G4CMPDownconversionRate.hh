@@ -9,6 +9,8 @@
 // $Id$
 //
 // 20170815  Move G4CMPProcessUtils inheritance to base class
+// 20261018  Compute rate from G4CMPRateContext, not from track
+// 20261018  Declare which G4CMPRateContext contents are used
 
 #ifndef G4CMPDownconversionRate_hh
 #define G4CMPDownconversionRate_hh 1
@@ -18,10 +20,12 @@
 
 class G4CMPDownconversionRate : public G4CMPVScatteringRate {
 public:
-  G4CMPDownconversionRate() : G4CMPVScatteringRate("Downconversion") {;}
+  G4CMPDownconversionRate() : G4CMPVScatteringRate("Downconversion", false,
+						  G4CMPRateContext::Energy) {;}
   virtual ~G4CMPDownconversionRate() {;}
 
-  virtual G4double Rate(const G4Track& aTrack) const;
+  using G4CMPVScatteringRate::Rate;
+  virtual G4double Rate(const G4CMPRateContext& ctx) const;
 };
 
 #endif	/* G4CMPDownconversionRate_hh */
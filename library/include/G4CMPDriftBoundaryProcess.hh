@@ -24,6 +24,7 @@
 // 20160906  Follow constness of G4CMPBoundaryUtils
 // 20170731  Split electron, hole reflection into utility functions
 // 20170802  Add EnergyPartition to handle phonon production
+// 20261018  Refresh surface data from BuildPhysicsTable()
 
 #ifndef G4CMPDriftBoundaryProcess_h
 #define G4CMPDriftBoundaryProcess_h 1
@@ -40,6 +41,9 @@ public:
   G4CMPDriftBoundaryProcess(const G4String& name = "G4CMPChargeBoundary");
   virtual ~G4CMPDriftBoundaryProcess();
 
+  // Refresh G4CMP surface data (on master) before tracking
+  virtual void BuildPhysicsTable(const G4ParticleDefinition&);
+
   virtual G4double PostStepGetPhysicalInteractionLength(const G4Track& track,
                                                    G4double previousStepSize,
                                                    G4ForceCondition* condition);
@@ -12,32 +12,25 @@
 // $Id$
 //
 // 20161111 Initial commit - R. Agnese
+// 20261018  Allocate from per-thread G4CMPTrackInfoPool
 
 #ifndef G4CMPDriftTrackInfo_hh
 #define G4CMPDriftTrackInfo_hh 1
 
 #include "G4CMPVTrackInfo.hh"
-/*
-#include "G4Allocator.hh"
-
-class G4CMPDriftTrackInfo;
-
-extern G4Allocator<G4CMPDriftTrackInfo> G4CMPDriftTrackInfoAllocator;
-*/
+#include "G4CMPTrackInfoPool.hh"
 
 class G4CMPDriftTrackInfo: public G4CMPVTrackInfo {
 public:
   G4CMPDriftTrackInfo() = delete;
   G4CMPDriftTrackInfo(const G4LatticePhysical* lat, G4int valIdx);
 
-/*
-  void *operator new(size_t) noexcept {
-    return static_cast<void*>(G4CMPDriftTrackInfoAllocator.MallocSingle());
+  void* operator new(size_t size) {
+    return G4CMPTrackInfoPool<G4CMPDriftTrackInfo>::Allocate(size);
   }
-  void operator delete(void* info) noexcept {
-    G4CMPDriftTrackInfoAllocator.FreeSingle(static_cast<G4CMPDriftTrackInfo*>(info));
+  void operator delete(void* info, size_t size) noexcept {
+    G4CMPTrackInfoPool<G4CMPDriftTrackInfo>::Free(info, size);
   }
-*/
 
   G4int ValleyIndex() const                                { return valleyIdx; }
   void SetValleyIndex(G4int valIdx);
@@ -0,0 +1,53 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+// Combined charge trapping and trap ionization process.  A single
+// interaction length is drawn from the summed rate of all trap channels
+// for the current carrier, then the channel is chosen by its branching
+// fraction.  Replaces G4CMPDriftTrappingProcess plus the two applicable
+// G4CMPDriftTrapIonization instances for each carrier type.
+//
+// 20261018  New process to reduce per-step overhead of separate trap MFPs
+
+#ifndef G4CMPDriftTrapAndIonization_h
+#define G4CMPDriftTrapAndIonization_h 1
+
+#include "G4CMPVDriftProcess.hh"
+
+class G4ParticleDefinition;
+
+
+class G4CMPDriftTrapAndIonization : public G4CMPVDriftProcess {
+public:
+  G4CMPDriftTrapAndIonization(const G4String& name = "TrapAndIonization");
+  virtual ~G4CMPDriftTrapAndIonization();
+
+  // Collect channel rates for current carrier type
+  virtual void LoadDataForTrack(const G4Track* aTrack);
+
+  virtual G4VParticleChange* PostStepDoIt(const G4Track&, const G4Step&);
+
+protected:
+  virtual G4double GetMeanFreePath(const G4Track&, G4double, G4ForceCondition*);
+
+  // Channel actions, selected in PostStepDoIt
+  G4VParticleChange* DoTrapping(const G4Track& aTrack);
+  G4VParticleChange* DoTrapIonization(const G4Track& aTrack,
+				      G4ParticleDefinition* trapPD);
+
+  // Inverse MFPs for each channel, filled from G4CMPConfigManager
+  enum { kTrapping=0, kDTrapIonization, kATrapIonization, kNChannels };
+  G4double channelRate[kNChannels];
+  G4double totalRate;
+
+private:
+  // No copying/moving
+  G4CMPDriftTrapAndIonization(G4CMPDriftTrapAndIonization&);
+  G4CMPDriftTrapAndIonization(G4CMPDriftTrapAndIonization&&);
+  G4CMPDriftTrapAndIonization& operator=(const G4CMPDriftTrapAndIonization&);
+  G4CMPDriftTrapAndIonization& operator=(const G4CMPDriftTrapAndIonization&&);
+};
+
+#endif	/* G4CMPDriftTrapAndIonization_h */
@@ -29,6 +29,13 @@
 // 20220216  Add interface to do partitioning directly from StepAccumulator.
 // 20220816  Add generated track counts, for convenience before filling
 // 20220816  G4CMP-308 -- Support generating multiple primary positions.
+// 20261018  Generate counts first, then fill particle list in random order
+// 20261018  Add QueuePrimaries() to deliver primaries through stacking
+// 20261018  Reuse primary and secondary buffers between calls
+// 20261018  Cache uniform field for bias estimate by volume and field
+// 20261018  QueuePrimaries() may be given stacking action directly
+// 20261018  Place charges at cloud bin centers; queue per-vertex counts
+// 20261018  Cache uniform field in its own frame, not per volume
 
 #ifndef G4CMPEnergyPartition_hh
 #define G4CMPEnergyPartition_hh 1
@@ -40,6 +47,7 @@
 
 class G4CMPChargeCloud;
 class G4CMPPartitionData;
+class G4CMPStackingAction;
 class G4CMPStepAccumulator;
 class G4Event;
 class G4LatticePhysical;
@@ -48,8 +56,10 @@ class G4ParticleDefinition;
 class G4PrimaryParticle;
 class G4PrimaryVertex;
 class G4Track;
+class G4UniformElectricField;
 class G4VParticleChange;
 class G4VPhysicalVolume;
+class G4VTouchable;
 
 
 class G4CMPEnergyPartition : public G4CMPProcessUtils {
@@ -114,6 +124,16 @@ public:
   void GetPrimaries(G4Event* event, const std::vector<G4ThreeVector>& pos,
 		    G4double time, G4int maxPerVertex=100000) const;
 
+  // Put only first chunk into event, with the rest queued in
+  // G4CMPStackingAction and tracked as the stack empties (bounds memory
+  // use for large deposits); without it, same as GetPrimaries()
+  void QueuePrimaries(G4Event* event, const G4ThreeVector& pos, G4double time,
+		      G4int maxPerVertex=100000) const;
+
+  void QueuePrimaries(G4CMPStackingAction* stacker, G4Event* event,
+		      const G4ThreeVector& pos, G4double time,
+		      G4int maxPerVertex=100000) const;
+
   void GetSecondaries(std::vector<G4Track*>& secondaries,
 		      G4double trkWeight=1.) const;
 
@@ -139,14 +159,21 @@ public:
 
 protected:
   void GenerateCharges(G4double energy);
-  void AddChargePair(G4double ePair, G4double wt);
+  void AddCharge(G4ParticleDefinition* pd, G4double ekin, G4double wt);
 
   void GeneratePhonons(G4double energy);
   void AddPhonon(G4double ePhon, G4double wt);
 
+  // Create generated charges and phonons, in random order
+  void FillParticles();
+
   G4PrimaryVertex* CreateVertex(G4Event* event, const G4ThreeVector& pos,
 				G4double time) const;
 
+  // Position for charges in cloud bin, or input position if bin is negative
+  G4ThreeVector GetBinPosition(const G4VTouchable* touch, G4int chgbin,
+			       const G4ThreeVector& pos) const;
+
   // Create buffer save DoPartition() computations
   G4CMPPartitionData* CreateSummary();
 
@@ -156,6 +183,9 @@ protected:
 
   G4Material* material;		// To get (Z,A) for Lindhard scaling
   G4double biasVoltage;		// Bias across volume for Luke downsampling
+  const G4UniformElectricField* biasField;	// Field for most recent bias
+  G4ThreeVector biasFieldValue;		// Field vector in biasField's frame
+  G4bool biasFieldIsLocal;		// Frame is volume-local (wrapped)
   G4double holeFraction;	// Energy from e/h pair taken by hole (50%)
   G4int nParticlesMinimum;	// Minimum production when downsampling
   G4bool applyDownsampling;	// Flag whether to do downsampling calcualtions
@@ -170,6 +200,11 @@ protected:
   size_t nPhononsGen;		// Number of direct phonons after downsampling
   G4double phononEnergyLeft;	// Energy to partition into phonons
 
+  G4double pairEnergy;		// Energy of each generated pair
+  G4double pairWeight;		// Weight of each generated charge
+  G4double phononEnergy;	// Energy of each generated phonon
+  G4double phononWeight;	// Weight of each generated phonon
+
   G4CMPPartitionData* summary;	// Summary block, saved to G4HitsCollection
 
   static const G4ThreeVector origin;
@@ -183,8 +218,14 @@ protected:
     Data(G4ParticleDefinition* part, const G4ThreeVector& d, G4double E,
 	 G4double w) : pd(part), dir(d), ekin(E), wt(w) {;}
   };
-    
+
+  G4PrimaryParticle* CreatePrimary(const Data& p) const;
+
   std::vector<Data> particles;	// Combined phonons and charge carriers
+
+  // Output buffers, reused between calls to avoid reallocation
+  mutable std::vector<G4PrimaryParticle*> primBuffer;
+  mutable std::vector<G4Track*> secBuffer;
 };
 
 #endif	/* G4CMPEnergyPartition_hh */
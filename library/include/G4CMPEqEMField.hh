@@ -18,6 +18,7 @@
 // 20140404  Drop unnecessary data members, using functions in G4LatticePhysical
 // 20170525  Add default "rule of five" copy/move operators
 // 20210920  Add verbosity with access to be used by G4CMPFieldManager
+// 20261018  Add acceleration and velocity conversions for exact stepping
 
 #ifndef G4CMPEqEMField_hh
 #define G4CMPEqEMField_hh
@@ -25,6 +26,7 @@
 #include "G4EqMagElectricField.hh"
 #include "G4AffineTransform.hh"
 #include "G4LatticePhysical.hh"
+#include "G4PhysicalConstants.hh"
 #include "G4RotationMatrix.hh"
 
 class G4ElectroMagneticField;
@@ -66,6 +68,22 @@ public:
 			 G4double dydx[]) const;
   // Given the value of the electromagnetic field, this function 
   // calculates the value of the derivative dydx.
+
+  // Carrier acceleration (global coordinates) for the given field value,
+  // using the valley mass tensor if a valley is set.  Used by
+  // G4CMPUniformFieldStepper for analytic propagation.
+  G4ThreeVector GetAcceleration(const G4double field[]) const;
+
+  // Convert between "pseudomomentum" y[3..5] and true carrier velocity
+  G4ThreeVector GetVelocity(const G4double y[]) const {
+    return G4ThreeVector(y[3], y[4], y[5])/(fMass*CLHEP::c_light);
+  }
+
+  void SetVelocity(const G4ThreeVector& v, G4double y[]) const {
+    y[3] = v.x()*fMass*CLHEP::c_light;
+    y[4] = v.y()*fMass*CLHEP::c_light;
+    y[5] = v.z()*fMass*CLHEP::c_light;
+  }
   
 private:
   const G4LatticePhysical* theLattice;
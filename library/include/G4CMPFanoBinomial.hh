@@ -10,6 +10,7 @@
 ///	   'p' probabilities derived from the input mean and sigma.
 //
 // 20201018  Michael Kelsey (TAMU) 
+// 20261018  Add alias-table sampling and batched array generation
 
 #ifndef G4CMPFanoBinomial_h
 #define G4CMPFanoBinomial_h 1
@@ -88,9 +89,25 @@ private:
   static double genBinomial( CLHEP::HepRandomEngine *anEngine,
 			     double mean, double fano );
 
+  // All array methods use this, so that setup is done once per call
+  static void genArray( CLHEP::HepRandomEngine *anEngine, const int size,
+			double* vect, double mean, double fano );
+
+  // Interpolated binomial, between integer N values above and below
+  static void interpParams(double mean, double fano, long& nlo, double& Plo,
+			   long& nhi, double& Phi, double& dP);
+
+  struct InterpTable;		// Sampling table for interpolated distribution
+  static InterpTable* getInterpTable(double mean, double fano);
+
+  static const long maxTableSize;
+
+  static double genInterpolated( CLHEP::HepRandomEngine *anEngine,
+				 double mean, double fano );
+
   static double pdfBinomial(long x, long n, double p);
 
-  static double Choose(long n, long x);
+  static double lnChoose(long n, long x);
 
   std::shared_ptr<CLHEP::HepRandomEngine> localEngine;
   double defaultMean;
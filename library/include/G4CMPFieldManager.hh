@@ -12,6 +12,7 @@
 // 20170801  Add counter to track instances of null-lattice, for reflections.
 // 20210901  Add local verbosity flag for reporting diagnostics; use instead
 //	     of G4CMP global setting.
+// 20261018  Use exact G4CMPUniformFieldStepper for uniform electric fields
 
 #ifndef G4CMPFieldManager_h
 #define G4CMPFieldManager_h 1
@@ -63,6 +64,7 @@ private:
 
   // NOTE: All pointers are kept in order to delete in dtor
   void CreateTransport();
+  void DeleteTransport();
   G4CMPEqEMField* theEqMotion;
   G4MagIntegratorStepper* theStepper;
   G4MagInt_Driver* theDriver;
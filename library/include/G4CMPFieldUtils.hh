@@ -12,6 +12,7 @@
 // Description: Free standing helper functions for electric field access
 //
 // 20180622  Michael Kelsey
+// 20261018  Add GetBiasThroughPosition() for already known field vector
 
 #include "G4ThreeVector.hh"
 
@@ -44,6 +45,11 @@ namespace G4CMP {
   G4double GetBiasThroughPosition(const G4VTouchable* touch,
 				  const G4ThreeVector& pos);
 
+  // Same, using field vector already evaluated in volume
+  G4double GetBiasThroughPosition(const G4LogicalVolume* vol,
+				  const G4ThreeVector& field,
+				  const G4ThreeVector& pos);
+
   // Return field handler if available for volume
   const G4CMPLocalElectroMagField* GetLocalField(const G4LogicalVolume* vol);
   const G4CMPMeshElectricField* GetMeshField(const G4LogicalVolume* vol);
@@ -18,6 +18,7 @@
 // 20170913  Add utility to get electric field at (global) position
 // 20170925  Add utility to create touchable at (global) position
 // 20190226  Use local instance of G4Navigator to avoid corrupting tracking
+// 20261018  Add reusable per-thread touchable for repeated point lookups
 
 #include "G4ThreeVector.hh"
 
@@ -62,6 +63,10 @@ namespace G4CMP {
   // NOTE:  Transfers ownership to client
   G4VTouchable* CreateTouchableAtPoint(const G4ThreeVector& pos);
 
+  // NOTE:  Touchable is reused by each call on the same thread; navigation
+  //	    is skipped if position is still inside the previous leaf volume
+  const G4VTouchable* LocateTouchableAtPoint(const G4ThreeVector& pos);
+
   G4ThreeVector ApplySurfaceClearance(const G4VTouchable* touch,
 				      G4ThreeVector pos);
 }
@@ -15,6 +15,7 @@
 // 20220821  G4CMP-308 -- Use new G4CMPStepInfo container instead of G4Step
 // 20220826  For use with primary generator, need to pass in G4Event*
 // 20220828  Add interface to process "left over" accumulators to primaries
+// 20261018  Replace accumulator map with dense slots and open-addressed index
 
 #ifndef G4CMPHitMerging_hh
 #define G4CMPHitMerging_hh 1
@@ -22,7 +23,6 @@
 #include "G4CMPProcessUtils.hh"
 #include "G4CMPStepAccumulator.hh"
 #include "G4ThreeVector.hh"
-#include <map>
 #include <vector>
 
 class G4CMPEnergyPartition;
@@ -77,6 +77,11 @@ protected:
   // Process accumulator for track unconditionally to new primaries
   void FlushAccumulator(G4int trkID, G4Event* primaryEvent);
 
+  // Find accumulator for track, assigning next free slot if needed
+  G4CMPStepAccumulator* GetAccumulator(G4int trkID);
+  void ClearAccumulators();			// Release all slots for reuse
+  void ResizeSlotIndex(size_t size);		// Rebuild index for used slots
+
   // Create secondaries along the specified trajectory
   void GeneratePositions(size_t npos, const G4ThreeVector& start,
 			 const G4ThreeVector& end);
@@ -89,8 +94,13 @@ private:
   G4double combiningStepLength;		// Steps within which to accumulate
   G4bool readyForOutput;		// Flag if hit data ready for use
 
-  // Collection of accumulators for individual tracks in event
-  std::map<G4int, G4CMPStepAccumulator> trackAccum;
+  // Accumulators for individual tracks in event, in order of first use.
+  // Slots are kept between events, so steady state needs no allocation.
+  std::vector<G4CMPStepAccumulator> accumSlots;
+  std::vector<G4int> slotTrackID;	// Track ID assigned to each slot
+  size_t nSlotsUsed;			// Slots in use for current event
+  std::vector<G4int> slotIndex;		// Open-addressed by track ID (-1=empty)
+
   G4CMPStepAccumulator* accumulator;	// Sums multiple steps along track
   G4int currentEventID;			// Remember event for clearing accums
 
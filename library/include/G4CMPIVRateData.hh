@@ -0,0 +1,44 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPIVRateData.hh
+/// \brief Definition of the G4CMPIVRateData container.  Holds constants
+///	   for the electron intervalley rate models (matrix element, linear
+///	   and quadratic), precomputed once per lattice by
+///	   G4LatticeLogical::Initialize() and shared read-only.
+//
+// 20261018  New container for per-lattice intervalley rate constants
+
+#ifndef G4CMPIVRateData_hh
+#define G4CMPIVRateData_hh 1
+
+#include "globals.hh"
+#include <vector>
+
+
+struct G4CMPIVRateData {
+  G4CMPIVRateData()
+    : alpha(0.), impurityScale(0.), impurityEnergy(0.), linRate0(0.),
+      linRate1(0.), linExponent(0.), quadRate(0.), quadField2(0.),
+      quadHalfExponent(0.) {;}
+
+  // Optical phonon branches, sorted by increasing threshold energy
+  std::vector<G4double> threshold;	// E_op for each branch
+  std::vector<G4double> opticalScale;	// N_v m_DOS^3/2 D_op^2 / (...E_op)
+
+  G4double alpha;			// Non-parabolicity of band
+  G4double impurityScale;		// Neutral impurity rate prefactor
+  G4double impurityEnergy;		// Impurity scattering energy scale E_T
+
+  // Field-dependent parametrizations
+  G4double linRate0;			// Constant term of linear model
+  G4double linRate1;			// Power-law term of linear model
+  G4double linExponent;			// Exponent of linear model (V/cm)
+  G4double quadRate;			// Rate factor of quadratic model
+  G4double quadField2;			// E_0^2 of quadratic model, (V/m)^2
+  G4double quadHalfExponent;		// Half exponent of quadratic model
+};
+
+#endif	/* G4CMPIVRateData_hh */
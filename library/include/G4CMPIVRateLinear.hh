@@ -10,6 +10,8 @@
 // $Id$
 //
 // 20170815  Move G4CMPProcessUtils inheritance to base class
+// 20261018  Compute rate from G4CMPRateContext, not from track
+// 20261018  Declare which G4CMPRateContext contents are used
 
 #ifndef G4CMPIVRateLinear_hh
 #define G4CMPIVRateLinear_hh 1
@@ -19,10 +21,12 @@
 
 class G4CMPIVRateLinear : public G4CMPVScatteringRate {
 public:
-  G4CMPIVRateLinear() : G4CMPVScatteringRate("IVLinear") {;}
+  G4CMPIVRateLinear() : G4CMPVScatteringRate("IVLinear", false,
+					       G4CMPRateContext::Field) {;}
   virtual ~G4CMPIVRateLinear() {;}
 
-  virtual G4double Rate(const G4Track& aTrack) const;
+  using G4CMPVScatteringRate::Rate;
+  virtual G4double Rate(const G4CMPRateContext& ctx) const;
 };
 
 #endif	/* G4CMPIVRateLinear_hh */
@@ -9,37 +9,37 @@
 // $Id$
 //
 // 20170919  Add interface for threshold identification
+// 20261018  Compute rate from G4CMPRateContext; drop track-based buffers
+// 20261018  Optical and neutral rates use per-lattice G4CMPIVRateData
+// 20261018  Declare which G4CMPRateContext contents are used
 
 #ifndef G4CMPInterValleyRate_hh
 #define G4CMPInterValleyRate_hh 1
 
 #include "G4CMPVScatteringRate.hh"
+#include "G4CMPIVRateData.hh"
 
 
 class G4CMPInterValleyRate : public G4CMPVScatteringRate {
 public:
   G4CMPInterValleyRate()
-    : G4CMPVScatteringRate("InterValley"),
-      hbar_sq(CLHEP::hbar_Planck*CLHEP::hbar_Planck), hbar_4th(hbar_sq*hbar_sq),
-      m_electron(CLHEP::electron_mass_c2/CLHEP::c_squared),
-      eTrk(0.), density(0.), kT(0.), uSound(0.), alpha(0.), nValley(0),
-      m_DOS(0.), m_DOS3half(0.) {;}
+    : G4CMPVScatteringRate("InterValley", false, G4CMPRateContext::Energy),
+      hbar_sq(CLHEP::hbar_Planck*CLHEP::hbar_Planck), hbar_4th(hbar_sq*hbar_sq) {;}
 
   virtual ~G4CMPInterValleyRate() {;}
 
-  virtual G4double Rate(const G4Track& aTrack) const;
+  using G4CMPVScatteringRate::Rate;
+  virtual G4double Rate(const G4CMPRateContext& ctx) const;
 
   virtual G4double Threshold(G4double Eabove=0.) const;
 
-  // Initialize numerical parameters below
-  virtual void LoadDataForTrack(const G4Track* track);
-
 protected:
-  G4double acousticRate() const;	// Acoustic intravalley rate
-  G4double opticalRate() const;		// Optical intervalley D0, D1 rate
-  G4double scatterRate() const;		// Neutral impurity scattering
+  // Individual rates, computed from lattice and track energy
+  G4double acousticRate(const G4LatticePhysical* lat, G4double eTrk) const;
+  G4double opticalRate(const G4CMPIVRateData& iv, G4double eTrk) const;
+  G4double scatterRate(const G4CMPIVRateData& iv, G4double eTrk) const;
 
-  G4double energyFunc(G4double E) const {	// Energy dependence of rates
+  G4double energyFunc(G4double E, G4double alpha) const {  // Energy dependence
     return sqrt(E*(1+alpha*E))*(1+2*alpha*E);
   }
 
@@ -47,18 +47,6 @@ private:
   // Useful numerical parameters for computing individual rates
   const G4double hbar_sq;
   const G4double hbar_4th;
-  const G4double m_electron;
-
-  // Kinematic parameters set by Rate()
-  mutable G4double eTrk;	// Track kinetic energy
-
-  G4double density;		// Crystal density (from G4Material)
-  G4double kT;			// Crystal temperature * k_B
-  G4double uSound;		// Average sound speed for acoustic rate
-  G4double alpha;		// Non-parabolicity parameter
-  G4int    nValley;		// Number of final-state valleys (2N-1)
-  G4double m_DOS;		// Electron "density of states" average mass
-  G4double m_DOS3half;		// m_DOS ^ (3/2)
 };
 
 #endif	/* G4CMPInterValleyRate_hh */
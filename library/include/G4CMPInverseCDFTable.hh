@@ -0,0 +1,69 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPInverseCDFTable.hh
+/// \brief Tabulated inverse cumulative distributions for sampling a
+///	   one-parameter family of densities p(u; s) on u in [0,1].
+///
+/// The table is filled once from any callable pdf(s,u), on a uniform grid
+/// of the parameter s.  Each row is the quantile function u(r) evaluated at
+/// equally spaced r, so that sampling is a direct lookup with linear
+/// interpolation in r and in s.  Rows are computed by integrating the
+/// density over fine cells (two-point Gauss-Legendre, so the endpoints
+/// u=0,1 are never evaluated) and inverting the piecewise-linear CDF.
+//
+// 20261018  New class for rejection-free sampling of tabulated densities
+
+#ifndef G4CMPInverseCDFTable_hh
+#define G4CMPInverseCDFTable_hh 1
+
+#include "globals.hh"
+#include <vector>
+
+
+class G4CMPInverseCDFTable {
+public:
+  G4CMPInverseCDFTable()
+    : parMin(0.), parMax(0.), parStep(0.), nPar(0), nQuant(0) {;}
+
+  // Fill table for parameter range [pmin,pmax] with nPar grid points;
+  // pdf(s,u) need not be normalized.  Use nPar=1 for a single density.
+  template <class PDF>
+  G4CMPInverseCDFTable(const PDF& pdf, G4double pmin, G4double pmax,
+		       G4int npar, G4int nquant=512, G4int nfine=4096) {
+    Initialize(pdf, pmin, pmax, npar, nquant, nfine);
+  }
+
+  template <class PDF>
+  void Initialize(const PDF& pdf, G4double pmin, G4double pmax,
+		  G4int npar, G4int nquant=512, G4int nfine=4096);
+
+  G4bool IsValid() const { return nPar > 0; }
+  G4bool InRange(G4double par) const { return par>=parMin && par<=parMax; }
+
+  G4double GetParMin() const { return parMin; }
+  G4double GetParMax() const { return parMax; }
+
+  // Return u in [0,1] for uniform random r in [0,1); parameter is clamped
+  G4double Sample(G4double par, G4double r) const;
+  G4double Sample(G4double r) const { return Sample(parMin, r); }
+
+protected:
+  // Convert fine-cell weights for parameter row into quantile table
+  void FillQuantiles(G4int ipar, const std::vector<G4double>& cellWeight);
+
+  // Quantile function for single parameter row
+  G4double RowQuantile(G4int ipar, G4double r) const;
+
+private:
+  G4double parMin, parMax, parStep;
+  G4int nPar;			// Number of parameter grid points
+  G4int nQuant;			// Quantile intervals per row (nQuant+1 values)
+  std::vector<G4double> quantile;	// Row-major [ipar][iq]
+};
+
+#include "G4CMPInverseCDFTable.icc"
+
+#endif	/* G4CMPInverseCDFTable_hh */
@@ -20,12 +20,22 @@
 // 20200701  G4CMP-217: New function to handle QP energy absorption below
 //		minimum for QP -> phonon -> new QP pair chain (3*bandgap).
 // 20201109  Add diagnostic text file (like downconversion and Luke).
+// 20261018  Add optional response library, sampling stored cascades in
+//		place of full simulation; move cascade to DoCascade().
+// 20261018  Process cascade by generations using reusable work buffers,
+//		with random numbers and escape probabilities filled per
+//		generation rather than per phonon.
+// 20261018  Move G4CMP_DEBUG text file out of class, to compile out fully.
+// 20261018  Validate response library nodes on read; merge nodes from all
+//		threads into cache, written via temporary file.
+// 20261018  Simulate cascades near 2*gap and lowQPLimit thresholds directly;
+//		write cache from SaveResponseLibrary(), not destructor.
 
 #ifndef G4CMPKaplanQP_hh
 #define G4CMPKaplanQP_hh 1
 
 #include "G4Types.hh"
-#include <fstream>
+#include "G4String.hh"
 #include <vector>
 
 class G4MaterialPropertiesTable;
@@ -59,12 +69,59 @@ public:
   G4double AbsorbPhonon(G4double energy,
 			std::vector<G4double>& reflectedEnergies) const;
 
+  // Sample film cascade from library of precomputed responses, rather
+  // than simulating each phonon.  Library bins are filled on first use,
+  // or read from a cache file for the same film parameters.  Phonons
+  // within a few gap energies of the pair-breaking and QP thresholds are
+  // always simulated, as stored cascades can't be scaled across them.
+  void UseResponseLibrary(G4bool value) { useLibrary = value; }
+  G4bool UsingResponseLibrary() const { return useLibrary; }
+
+  // Merge newly filled nodes into cache file.  Nothing is written unless
+  // this is called; applications should call SaveResponseLibraries() from
+  // G4UserRunAction::EndOfRunAction(), which runs on every thread.
+  G4bool SaveResponseLibrary() const;
+  static void SaveResponseLibraries();		// All instances on thread
+
+  // Cache files are written to a temporary name and renamed into place,
+  // so readers never see partial files.  Nodes which are incomplete or
+  // do not conserve energy are dropped on read, and refilled when used.
+  G4bool ReadResponseLibrary(const G4String& filename);
+  G4bool WriteResponseLibrary(const G4String& filename) const;
+
 protected:
+  // Simulate full phonon/QP cascade for phonon which has entered film
+  G4double DoCascade(G4double energy,
+		     std::vector<G4double>& reflectedEnergies) const;
+
+  // Pick stored cascade from library node near energy, scaled to energy
+  G4double SampleResponse(G4double energy,
+			  std::vector<G4double>& reflectedEnergies) const;
+
+  // Run cascades at library node energy and store results as fractions
+  void FillResponseNode(size_t inode) const;
+
+  // Lowest energy taken from library; cascades below are simulated
+  G4double ResponseMinEnergy() const;
+
+  // Library access for current film configuration
+  G4bool LoadResponseLibrary(const G4String& filename) const;
+  void ClearResponseLibrary();
+  G4String ResponseLibraryKey() const;
+  G4String ResponseCacheFile(const G4String& key) const;
+
   // Compute the probability of a phonon reentering the crystal without breaking
   // any Cooper pairs.
   G4double CalcEscapeProbability(G4double energy,
 				 G4double thicknessFrac) const;
 
+  // Fill escape probabilities (thicknessFrac = 0.5) for whole generation
+  void CalcEscapeProbabilities(const std::vector<G4double>& phonEnergies,
+			       std::vector<G4double>& escapeProbs) const;
+
+  // Get block of uniform random numbers for whole generation
+  const G4double* FillRandomBuffer(size_t n) const;
+
   // Model the phonons (phonEnergies) breaking Cooper pairs into quasiparticles
   // (qpEnergies).
   G4double CalcQPEnergies(std::vector<G4double>& phonEnergies,
@@ -91,11 +148,14 @@ protected:
 			    std::vector<G4double>& qpEnergies) const;
 
   // Compute quasiparticle energy distribution from broken Cooper pair.
+  // Second version takes uniform random value for tabulated sampling
   G4double QPEnergyRand(G4double Energy) const;
+  G4double QPEnergyRand(G4double Energy, G4double rand) const;
   G4double QPEnergyPDF(G4double E, G4double x) const;
   
   // Compute phonon energy distribution from quasiparticle in superconductor.
   G4double PhononEnergyRand(G4double Energy) const;
+  G4double PhononEnergyRand(G4double Energy, G4double rand) const;
   G4double PhononEnergyPDF(G4double E, G4double x) const;
 
   // Encapsulate below-bandgap logic
@@ -113,7 +173,36 @@ private:
   G4double phononLifetimeSlope;	// Energy dependence of phonon lifetime
   G4double vSound;		// Speed of sound in film
 
-  mutable std::ofstream output;		// Diagnostic output under G4CMP_DEBUG
+  // Cascade work buffers, reused between calls to avoid reallocation.
+  // Instances are per thread, so buffers need no locking.
+  mutable std::vector<G4double> phonBuffer;	// Phonons in current generation
+  mutable std::vector<G4double> qpBuffer;	// QPs in current generation
+  mutable std::vector<G4double> nextBuffer;	// Next generation being filled
+  mutable std::vector<G4double> randBuffer;	// Uniform randoms for generation
+  mutable std::vector<G4double> probBuffer;	// Escape probabilities
+  static const size_t bufferReserve;		// Initial capacity of buffers
+
+  // Response library:  nodes are log-spaced in energy from ResponseMinEnergy,
+  // each with responseSamples cascades stored as fractions of node energy
+  struct ResponseNode {
+    std::vector<G4double> absorbed;	// Absorbed fraction for each cascade
+    std::vector<size_t> first;		// Start of each cascade in reflected
+    std::vector<G4double> reflected;	// Re-emitted phonon fractions
+  };
+
+  G4bool useLibrary;			// Use library instead of cascade
+  mutable G4bool libraryChanged;	// New nodes filled since last read
+  mutable G4String libraryKey;		// Film parameters for library nodes
+  mutable std::vector<ResponseNode> responseLib;
+
+  // Read valid nodes from cache file; add cached nodes not yet filled here
+  G4bool ReadResponseNodes(const G4String& filename,
+			   std::vector<ResponseNode>& nodes) const;
+  void MergeResponseLibrary(const G4String& filename) const;
+
+  static const G4int responsePerDecade;	// Library nodes per decade
+  static const G4int responseSamples;	// Cascades stored per node
+  static const G4double responseMinGaps;	// Minimum library energy/gap
 };
 
 #endif	/* G4CMPKaplanQP_hh */
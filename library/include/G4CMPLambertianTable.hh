@@ -0,0 +1,79 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPLambertianTable.hh
+/// \brief Definition of the G4CMPLambertianTable class.  Tabulates the
+///	   region of a Lambertian (cos theta) reflection distribution for
+///	   which a phonon's group velocity points into the volume, for one
+///	   lattice, phonon mode and surface normal.
+///
+/// Directions are parametrized by s = sin^2(theta) and phi about the
+/// inward normal, so that the Lambertian distribution is uniform in (s,phi).
+/// Grid cells which contain (or border) inward-going directions form an
+/// envelope which is sampled uniformly, with each trial direction tested
+/// exactly.  Almost all trials are accepted, so diffuse reflection has a
+/// bounded cost even in strongly anisotropic crystals.
+///
+/// Tables are built on demand and cached per thread by GetTable() (see
+/// G4CMPSurfaceTableCache).  If no table is returned, callers should use
+/// simple rejection sampling.
+//
+// 20261018  New class for rejection-free diffuse phonon reflection
+// 20261018  Move per-thread cache to G4CMPSurfaceTableCache
+
+#ifndef G4CMPLambertianTable_hh
+#define G4CMPLambertianTable_hh 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include <vector>
+
+class G4LatticePhysical;
+
+
+class G4CMPLambertianTable {
+public:
+  G4CMPLambertianTable(const G4LatticePhysical* lat, G4int mode,
+		       const G4ThreeVector& surfNorm);
+  virtual ~G4CMPLambertianTable() {;}
+
+  // Cached table for current thread, or null if one should not be used
+  static const G4CMPLambertianTable* GetTable(const G4LatticePhysical* lat,
+					      G4int mode,
+					      const G4ThreeVector& surfNorm);
+
+  G4bool IsValid() const { return !envelope.empty(); }
+
+  // Inward wavevector direction from Lambertian distribution about surfNorm
+  // NOTE:  surfNorm should be the one used to build the table, to within
+  //	    roundoff, and is used for the final direction and inward test.
+  G4ThreeVector Sample(const G4ThreeVector& surfNorm) const;
+
+  // Fraction of Lambertian distribution covered by envelope cells
+  G4double GetEnvelopeFraction() const;
+
+protected:
+  // Convert (s,phi) grid coordinates to wavevector direction about normal
+  G4ThreeVector Direction(const G4ThreeVector& surfNorm,
+			  G4double s, G4double phi) const;
+
+  G4bool IsInward(const G4ThreeVector& kdir,
+		  const G4ThreeVector& surfNorm) const;
+
+  void FillEnvelope(const G4ThreeVector& surfNorm);
+
+private:
+  const G4LatticePhysical* lattice;
+  G4int mode;
+
+  std::vector<G4int> envelope;		// Cell indices (is*nPhi+iphi) to sample
+
+  static const G4int nS;		// Grid divisions in sin^2(theta)
+  static const G4int nPhi;		// Grid divisions in phi
+  static const G4int nProbe;		// Test points per cell edge
+  static const G4int maxTries;		// Limit on trials in Sample()
+};
+
+#endif	/* G4CMPLambertianTable_hh */
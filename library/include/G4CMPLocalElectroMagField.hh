@@ -12,6 +12,7 @@
 // 20180711  Store local geometry associated with field, and accessor to
 //		optionally interpolate potential
 // 20210902  Add verbosity flag set in constructing client code
+// 20261018  Add query for uniform field, to select exact stepper
 
 #ifndef G4CMPLocalElectroMagField_hh
 #define G4CMPLocalElectroMagField_hh 1
@@ -72,6 +73,9 @@ public:
   // This is mainly useful for field subclasses with extended interfaces
   const G4ElectroMagneticField* GetLocalField() const { return localField; }
 
+  // Report whether wrapped field is a G4UniformElectricField
+  G4bool IsUniformField() const;
+
 protected:
   void GetLocalPoint(const G4double Point[4]) const;
   void CopyLocalToGlobalVector(G4int index, G4double* gbl) const;
@@ -11,6 +11,8 @@
 // 20170815  Move G4CMPProcessUtils inheritance to base class
 // 20170907  Make process non-forced; TimeStepper will trigger recalculation
 // 20170919  Add interface for threshold identification
+// 20261018  Compute rate from G4CMPRateContext, not from track
+// 20261018  Declare which G4CMPRateContext contents are used
 
 #ifndef G4CMPLukeEmissionRate_hh
 #define G4CMPLukeEmissionRate_hh 1
@@ -20,10 +22,12 @@
 
 class G4CMPLukeEmissionRate : public G4CMPVScatteringRate {
 public:
-  G4CMPLukeEmissionRate() : G4CMPVScatteringRate("Luke") {;}
+  G4CMPLukeEmissionRate()
+    : G4CMPVScatteringRate("Luke", false, G4CMPRateContext::HVWaveVector) {;}
   virtual ~G4CMPLukeEmissionRate() {;}
 
-  virtual G4double Rate(const G4Track& aTrack) const;
+  using G4CMPVScatteringRate::Rate;
+  virtual G4double Rate(const G4CMPRateContext& ctx) const;
   virtual G4double Threshold(G4double Eabove=0.) const;
 };
 
@@ -13,6 +13,7 @@
 // 20170805  Remove GetMeanFreePath() function to scattering-rate model
 // 20190816  Add flag to track secondary phonons immediately (c.f. G4Cerenkov)
 // 20201109  Drop G4CMP_DEBUG protection here, to avoid client rebuilding
+// 20261018  Suppress own MFP when G4CMPTimeStepper uses uniformization.
 
 #ifndef G4CMPLukeScattering_h
 #define G4CMPLukeScattering_h 1
@@ -38,6 +39,10 @@ public:
   void SetTrackSecondariesFirst(const G4bool val) { secondariesFirst = val; }
   G4bool GetTrackSecondariesFirst() const { return secondariesFirst; }
 
+protected:
+  // With uniformization, G4CMPTimeStepper selects Luke emission instead
+  virtual G4double GetMeanFreePath(const G4Track&, G4double, G4ForceCondition*);
+
 private:
   // hide assignment operator as private
   G4CMPLukeScattering(G4CMPLukeScattering&);
@@ -0,0 +1,80 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPNIELTable.hh
+/// \brief Definition of the G4CMPNIELTable class.  Tabulates the yield
+///	   returned by a G4VNIELPartition function for one material and
+///	   projectile, for fast lookup in G4CMPEnergyPartition.
+///
+/// The yield is stored on a grid uniform in log(E), with the spacing
+/// refined when the table is built until linear interpolation at every
+/// interval midpoint agrees with the function to within maxError.
+/// Energies outside the grid are passed to the function directly.
+///
+/// Tables are built on demand by GetTable() and kept for the job; they
+/// are shared read-only by all threads.  Functions which give non-finite
+/// values, or cannot meet the error bound, are not tabulated and GetTable()
+/// returns null.
+///
+/// Tables are keyed by the function's address.  ReleaseTables() must be
+/// called before a NIEL function is deleted (G4CMPConfigManager does this),
+/// so that a new function allocated at the same address gets new tables.
+//
+// 20261018  New class for tabulated NIEL partition yields
+// 20261018  Release tables when NIEL function is replaced; free caches
+
+#ifndef G4CMPNIELTable_hh
+#define G4CMPNIELTable_hh 1
+
+#include "globals.hh"
+#include <vector>
+
+class G4Material;
+class G4VNIELPartition;
+
+
+class G4CMPNIELTable {
+public:
+  G4CMPNIELTable(const G4VNIELPartition* niel, const G4Material* mat,
+		 G4double Z, G4double A);
+  virtual ~G4CMPNIELTable() {;}
+
+  // Shared table for function, material and projectile, or null if the
+  // function should be called directly
+  static const G4CMPNIELTable* GetTable(const G4VNIELPartition* niel,
+					const G4Material* mat,
+					G4double Z=0., G4double A=0.);
+
+  // Drop tables for function which is about to be deleted
+  static void ReleaseTables(const G4VNIELPartition* niel);
+
+  G4bool IsValid() const { return !yield.empty(); }
+
+  // Same result as niel->PartitionNIEL(energy, mat, Z, A), within maxError
+  G4double GetYield(G4double energy) const;
+
+protected:
+  G4double Evaluate(G4double energy) const;
+  void FillTable();
+
+  // Largest interpolation error at interval midpoints of current table
+  G4double MaxMidpointError() const;
+
+private:
+  const G4VNIELPartition* nielFunc;
+  const G4Material* material;
+  G4double projZ, projA;
+
+  std::vector<G4double> yield;		// Values at lnEmin + i*lnStep
+  G4double lnStep, invStep;
+
+  static const G4double Emin, Emax;	// Energy range of table
+  static const G4int minPerDecade;	// Initial grid density
+  static const G4int maxPerDecade;	// Limit of refinement
+  static const G4double maxError;	// Interpolation tolerance on yield
+  static const size_t maxTables;	// Limit on distinct projectiles
+};
+
+#endif	/* G4CMPNIELTable_hh */
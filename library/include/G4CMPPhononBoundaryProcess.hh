@@ -13,6 +13,7 @@
 // 20181010  J. Singh -- Use new G4CMPAnharmonicDecay for boundary decays
 // 20181011  M. Kelsey -- Add LoadDataForTrack() to initialize decay utility.
 // 20220906  M. Kelsey -- Encapsulate specular reflection in function.
+// 20261018  Refresh surface data from BuildPhysicsTable()
 
 #ifndef G4CMPPhononBoundaryProcess_h
 #define G4CMPPhononBoundaryProcess_h 1
@@ -32,6 +33,9 @@ public:
   // Configure for current track including AnharmonicDecay utility
   virtual void LoadDataForTrack(const G4Track* track);
 
+  // Refresh G4CMP surface data (on master) before tracking
+  virtual void BuildPhysicsTable(const G4ParticleDefinition&);
+
   virtual G4double PostStepGetPhysicalInteractionLength(const G4Track& track,
                                                 G4double previousStepSize,
                                                 G4ForceCondition* condition);
@@ -29,6 +29,11 @@
 // directly absorb phonons below 2*bandgap.
 // 
 // 20221006  M. Kelsey -- Adapted from SuperCDMS simulation version
+// 20261018  Cache film absorption probability on first use.
+// 20261018  Build film model when table is assigned, and for each clone,
+//		so that each thread has its own instance ready before use.
+// 20261018  Create re-emitted phonons as a batch, with reusable buffers.
+// 20261018  Reload film absorption probability when surface table changes.
 
 #ifndef G4CMPPhononElectrode_hh
 #define G4CMPPhononElectrode_hh 1
@@ -46,16 +51,22 @@ public:
   G4CMPPhononElectrode();
   virtual ~G4CMPPhononElectrode();
 
-  // Implement cloning function along with default copiers
-  G4CMPPhononElectrode(const G4CMPPhononElectrode&) = default;
-  G4CMPPhononElectrode(G4CMPPhononElectrode&&) = default;
-  G4CMPPhononElectrode& operator=(const G4CMPPhononElectrode&) = default;
-  G4CMPPhononElectrode& operator=(G4CMPPhononElectrode&&) = default;
+  // Copying creates a new film model, so that each clone has its own
+  G4CMPPhononElectrode(const G4CMPPhononElectrode& rhs);
+  G4CMPPhononElectrode(G4CMPPhononElectrode&&) = delete;
+  G4CMPPhononElectrode& operator=(const G4CMPPhononElectrode&) = delete;
+  G4CMPPhononElectrode& operator=(G4CMPPhononElectrode&&) = delete;
 
   virtual G4CMPVElectrodePattern* Clone() const {
     return new G4CMPPhononElectrode(*this);
   }
 
+  // Create film model from new table
+  virtual void UseSurfaceTable(G4MaterialPropertiesTable* surfProp);
+
+  // Discard cached film absorption when table is refilled
+  virtual void SurfaceTableUpdated() { filmAbsorption = -1.; }
+
   // Assumes that user has configured a border surface only at sensor pads
   virtual G4bool IsNearElectrode(const G4Step&) const;
 
@@ -64,6 +75,9 @@ public:
                                  G4ParticleChange&) const;
 
 protected:
+  // Create film model and secondary buffer from current table
+  void BuildFilmModel();
+
   // Record energy deposition and re-emitted energies as secondary phonons
   void ProcessAbsorption(const G4Track& track, const G4Step& step,
 			 G4double EDep, G4ParticleChange& particleChange) const;
@@ -74,7 +88,13 @@ protected:
 
   // NOTE: "Mutable" because AbsorbAtElectrode() function is const
   mutable G4CMPKaplanQP* kaplanQP;	// Create instance of QET simulator
-  mutable std::vector<G4double> phononEnergies;		// Reusable buffer
+  mutable std::vector<G4double> phononEnergies;		// Reusable buffers
+  mutable std::vector<G4int> phononModes;
+  mutable std::vector<G4ThreeVector> phononWaveVecs;
+  mutable std::vector<G4Track*> phononTracks;
+  mutable G4double filmAbsorption;	// From surface table, <0 until loaded
+
+  static const size_t secondaryReserve;	// Initial capacity of buffer
 };
 
 #endif
@@ -13,34 +13,28 @@
 //
 // 20161111 Initial commit - R. Agnese
 // 20170728 M. Kelsey -- Replace "k" function args with "theK" (-Wshadow)
+// 20261018  Allocate from per-thread G4CMPTrackInfoPool
 
 #ifndef G4CMPPhononTrackInfo_hh
 #define G4CMPPhononTrackInfo_hh 1
 
 #include "G4CMPVTrackInfo.hh"
+#include "G4CMPTrackInfoPool.hh"
 #include "G4ThreeVector.hh"
 
-/* NOTE: Avoiding use of G4Allocator for performance reasons
-#include "G4Allocator.hh"
-class G4CMPPhononTrackInfo;
-extern G4Allocator<G4CMPPhononTrackInfo> G4CMPPhononTrackInfoAllocator;
-*/
-
 
 class G4CMPPhononTrackInfo : public G4CMPVTrackInfo {
 public:
   G4CMPPhononTrackInfo() = delete;
   G4CMPPhononTrackInfo(const G4LatticePhysical* lat, G4ThreeVector k);
 
-/* NOTE: Avoiding use of G4Allocator for performance reasons
-  void *operator new(size_t) noexcept {
-    return static_cast<void*>(G4CMPPhononTrackInfoAllocator.MallocSingle());
+  // NOTE: Uses per-thread pool rather than global G4Allocator
+  void* operator new(size_t size) {
+    return G4CMPTrackInfoPool<G4CMPPhononTrackInfo>::Allocate(size);
   }
-
-  void operator delete(void* info) noexcept {
-    G4CMPPhononTrackInfoAllocator.FreeSingle(static_cast<G4CMPPhononTrackInfo*>(info));
+  void operator delete(void* info, size_t size) noexcept {
+    G4CMPTrackInfoPool<G4CMPPhononTrackInfo>::Free(info, size);
   }
-*/
 
   void SetK(G4ThreeVector theK)          { waveVec = theK; }
   void SetWaveVector(G4ThreeVector theK) { waveVec = theK; }
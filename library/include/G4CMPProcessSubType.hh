@@ -9,6 +9,8 @@
 // 20200331 C. Stanford G4CMP-195:  Add Trapping and Impact subtypes
 // 20200501 G4CMP-196: Need separate processes for A- and D- charge traps
 // 20200504 M. Kelsey -- Remove impact subtype here; set values explicitly
+// 20261018 Add combined trapping and trap-ionization subtype
+// 20261018 Add combined phonon scattering and downconversion subtype
 
 #ifndef G4CMPProcessSubType_hh
 #define G4CMPProcessSubType_hh 1
@@ -31,7 +33,9 @@ enum G4CMPProcessSubType {
   fChargeRecombine = 310,
   fDTrapIonization = 311,
   fATrapIonization = 312,
-  fChargeTrapping = 313
+  fChargeTrapping = 313,
+  fChargeTrapAndIonization = 314,
+  fPhononScatteringAndDecay = 315
 };
 
 #endif	/* G4CMPProcessSubType_hh */
@@ -36,12 +36,15 @@
 // 20201111  Add MakePhononEnergy() which takes wave vector directly
 // 20201124  Change argument name in MakeGlobalRecoil() to 'krecoil' (track)
 // 20201223  Add FindNearestValley() function to align electron momentum.
+// 20261018  Add MakeRateContext() to collect kinematics for rate models.
+// 20261018  MakeRateContext() fills only contents requested by rate model
 
 #ifndef G4CMPProcessUtils_hh
 #define G4CMPProcessUtils_hh 1
 
 #include "globals.hh"
 #include "G4AffineTransform.hh"
+#include "G4CMPRateContext.hh"
 #include "G4RotationMatrix.hh"
 #include "G4ThreeVector.hh"
 #include "G4Track.hh"
@@ -239,6 +242,11 @@ public:
   // Parameters are "Mach number" (ratio to sound speed) and scattering length
   G4double ChargeCarrierTimeStep(G4double mach, G4double l0) const;
 
+  // Collect kinematics of track for scattering rate calculations
+  // Only contents in "needs" (G4CMPRateContext::Contents mask) are filled
+  G4CMPRateContext MakeRateContext(const G4Track& track,
+				   G4int needs=G4CMPRateContext::All) const;
+
 protected:
   const G4LatticePhysical* theLattice;	// For convenient access by processes
 
@@ -0,0 +1,46 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPRateContext.hh
+/// \brief Definition of the G4CMPRateContext container.  Collects the
+///	   per-step kinematics needed by G4CMPVScatteringRate subclasses,
+///	   so that rate models are pure functions of these values.  Filled
+///	   once per step by the owning process (see G4CMPProcessUtils::
+///	   MakeRateContext()) and passed by const reference.
+//
+// 20261018  New container to avoid track reloading in Rate() functions
+// 20261018  Flag contents, so that only quantities used are computed
+
+#ifndef G4CMPRateContext_hh
+#define G4CMPRateContext_hh 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+class G4LatticePhysical;
+class G4ParticleDefinition;
+
+
+struct G4CMPRateContext {
+  // Optional contents, requested by rate models (lattice, particle,
+  // valley and velocity are always filled)
+  enum Contents { Energy=1, WaveVector=2, HVWaveVector=4, Field=8, All=15 };
+
+  G4CMPRateContext() : lattice(0), particle(0), valley(-1), energy(0.),
+		       hasField(false), contents(0) {;}
+
+  const G4LatticePhysical* lattice;	// Lattice for current volume
+  const G4ParticleDefinition* particle;	// Phonon or charge carrier type
+  G4int valley;				// Electron valley index, -1 otherwise
+  G4double energy;			// Kinetic energy (from band structure)
+  G4ThreeVector vLocal;			// Velocity in local coordinates
+  G4ThreeVector kLocal;			// Wavevector in local coordinates
+  G4ThreeVector kHV;			// Herring-Vogt wavevector (electrons)
+  G4ThreeVector field;			// Electric field in local coordinates
+  G4bool hasField;			// Volume has field (may be zero)
+  G4int contents;			// Mask of Contents which were filled
+};
+
+#endif	/* G4CMPRateContext_hh */
@@ -0,0 +1,60 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPSamplingContext.hh
+/// \brief Definition of the G4CMPSamplingContext class.  Carries the
+///	   downsampling factors (primary phonons, primary charges, Luke
+///	   phonons) in effect for the current energy partition, so that
+///	   G4CMPConfigManager keeps the user's settings unchanged.
+///
+/// G4CMPEnergyPartition resets the context from G4CMPConfigManager at the
+/// start of each partition, then stores any computed scale factors here.
+/// Track weighting (G4CMP::ChoosePhononWeight(), ChooseChargeWeight()) and
+/// Luke emission read the active factors from Current().  If the user
+/// changes a configured value (e.g., by macro command), the context is
+/// reset to match.
+///
+/// There is one context per thread, shared by all partitions on it.
+//
+// 20261018  New class for per-partition sampling, leaving config unchanged
+
+#ifndef G4CMPSamplingContext_hh
+#define G4CMPSamplingContext_hh 1
+
+#include "globals.hh"
+
+
+class G4CMPSamplingContext {
+public:
+  // Active context for current thread, synchronized with configuration
+  static G4CMPSamplingContext& Current();
+
+  // Restore user's settings from G4CMPConfigManager
+  void Reset();
+
+  G4double GetGenPhonons() const   { return genPhonons; }
+  G4double GetGenCharges() const   { return genCharges; }
+  G4double GetLukeSampling() const { return lukeSample; }
+
+  void SetGenPhonons(G4double value)   { genPhonons = value; }
+  void SetGenCharges(G4double value)   { genCharges = value; }
+  void SetLukeSampling(G4double value) { lukeSample = value; }
+
+private:
+  G4CMPSamplingContext();
+  ~G4CMPSamplingContext() {;}
+
+  G4bool ConfigChanged() const;		// User setting differs from Reset()
+
+  G4double genPhonons;		// Active factors, may be computed
+  G4double genCharges;
+  G4double lukeSample;
+
+  G4double userPhonons;		// Configured values at last Reset()
+  G4double userCharges;
+  G4double userLuke;
+};
+
+#endif	/* G4CMPSamplingContext_hh */
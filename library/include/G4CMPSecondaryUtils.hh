@@ -14,15 +14,18 @@
 // 20170815 M. Kelsey -- Move AdjustSecondaryPosition to GeometryUtils
 // 20170928 M. Kelsey -- Replace "polarization" with "mode"
 // 20220907 G4CMP-316 -- Pass track into CreateXYZ() functions.
+// 20261018  Add CreatePhonons() and AddSecondaries() for batches.
 
 #ifndef G4CMPSecondaryUtils_hh
 #define G4CMPSecondaryUtils_hh 1
 
 #include "globals.hh"
 #include "G4ThreeVector.hh"
+#include <vector>
 
 class G4ParticleDefinition;
 class G4Track;
+class G4VParticleChange;
 class G4VTouchable;
 
 
@@ -44,6 +47,20 @@ namespace G4CMP {
 			       const G4ThreeVector& p,
 			       const G4ThreeVector& pos);
 
+  // Batch of phonons from one position and time, such as re-emission from
+  // a film.  Lattice, coordinate transform and surface clearance are done
+  // once.  New tracks are appended to secondaries, a buffer the caller
+  // should keep between calls.
+  void CreatePhonons(const G4Track& track, const std::vector<G4int>& modes,
+		     const std::vector<G4ThreeVector>& waveVecs,
+		     const std::vector<G4double>& energies, G4double time,
+		     const G4ThreeVector& pos,
+		     std::vector<G4Track*>& secondaries);
+
+  // Move all tracks from buffer to particle change, leaving buffer empty
+  void AddSecondaries(G4VParticleChange& particleChange,
+		      std::vector<G4Track*>& secondaries);
+
   // DEPRECATED: Version used by application code with output of G4CMPKaplanQP
   G4Track* CreatePhonon(const G4VTouchable* touch, G4int mode,
 			const G4ThreeVector& waveVec, G4double energy,
@@ -0,0 +1,84 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPSpecularTable.hh
+/// \brief Definition of the G4CMPSpecularTable class.  Tabulates the
+///	   correction needed for a mirror-reflected phonon wavevector to
+///	   have inward group velocity, for one lattice, phonon mode and
+///	   surface normal.
+///
+/// The corrected wavevector is unit(k - c*n), where k is the mirrored
+/// wavevector and n the outward normal.  The table stores the smallest c
+/// giving zero normal group velocity, on a grid of k directions in the
+/// surface frame (s = sin^2(theta) and phi about the inward normal).
+/// Interpolated values are the starting point for one Newton step, so a
+/// correction costs a few kinematic lookups instead of an iterative scan.
+///
+/// Tables are built on demand and cached per thread by GetTable() (see
+/// G4CMPSurfaceTableCache).  If no table is returned, or Correct() fails,
+/// callers should use their iterative correction.
+//
+// 20261018  New class for tabulated specular reflection correction
+
+#ifndef G4CMPSpecularTable_hh
+#define G4CMPSpecularTable_hh 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include <vector>
+
+class G4LatticePhysical;
+
+
+class G4CMPSpecularTable {
+public:
+  G4CMPSpecularTable(const G4LatticePhysical* lat, G4int mode,
+		     const G4ThreeVector& surfNorm);
+  virtual ~G4CMPSpecularTable() {;}
+
+  // Cached table for current thread, or null if one should not be used
+  static const G4CMPSpecularTable* GetTable(const G4LatticePhysical* lat,
+					    G4int mode,
+					    const G4ThreeVector& surfNorm);
+
+  G4bool IsValid() const { return nValid > 0; }
+
+  // Adjust mirrored wavevector direction so group velocity is inward;
+  // returns false, with kdir unchanged, if no correction was found
+  G4bool Correct(G4ThreeVector& kdir, const G4ThreeVector& surfNorm) const;
+
+protected:
+  // Normal component of group velocity direction (negative is inward)
+  G4double NormalVelocity(const G4ThreeVector& kdir,
+			  const G4ThreeVector& surfNorm) const;
+
+  // Same for wavevector corrected by c, unit(kdir - c*surfNorm)
+  G4double NormalVelocity(const G4ThreeVector& kdir,
+			  const G4ThreeVector& surfNorm, G4double c) const;
+
+  // Smallest c where normal velocity changes sign; negative if none
+  G4double FindCorrection(const G4ThreeVector& kdir,
+			  const G4ThreeVector& surfNorm) const;
+
+  // Interpolate grid for wavevector direction; negative if unavailable
+  G4double Interpolate(const G4ThreeVector& kdir,
+		       const G4ThreeVector& surfNorm) const;
+
+  void FillTable(const G4ThreeVector& surfNorm);
+
+private:
+  const G4LatticePhysical* lattice;
+  G4int mode;
+
+  std::vector<G4double> correction;	// Grid nodes [is*nPhi+iphi]
+  G4int nValid;				// Nodes with correction found
+
+  static const G4int nS;		// Grid divisions in sin^2(theta)
+  static const G4int nPhi;		// Grid divisions in phi
+  static const G4int nScan;		// Steps in c to bracket sign change
+  static const G4double maxCorrection;	// Limit of c for scan
+};
+
+#endif	/* G4CMPSpecularTable_hh */
@@ -9,6 +9,8 @@
 // $Id$
 //
 // 20170525  M. Kelsey -- Add default "rule of five" copy/move operators
+// 20261018  Add queue of primaries delivered in chunks at each new stage
+// 20261018  Queue per-vertex counts; draw tracks as each chunk is pushed
 
 #ifndef G4CMPStackingAction_h
 #define G4CMPStackingAction_h 1
@@ -16,7 +18,11 @@
 #include "globals.hh"
 #include "G4UserStackingAction.hh"
 #include "G4CMPProcessUtils.hh"
+#include "G4ThreeVector.hh"
+#include <vector>
 
+class G4Event;
+class G4LatticePhysical;
 class G4Track;
 
 class G4CMPStackingAction
@@ -27,13 +33,55 @@ public:
 
 public:
   virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* aTrack);
+  virtual void NewStage();
+  virtual void PrepareNewEvent();
+
+  // Queue of tracks pushed onto urgent stack in chunks, each time it empties
+  // (see G4CMPEnergyPartition::QueuePrimaries()); one track at a time is
+  // held on the waiting stack so that NewStage() is called for next chunk.
+  // Only counts, energies and weights are kept for each vertex; particle
+  // order, directions and phonon modes are drawn when a chunk is pushed.
+  struct QueuedVertex {
+    G4ThreeVector pos;
+    G4double time;
+    const G4LatticePhysical* lattice;	// For phonon mode selection
+    size_t nElec, nHole, nPhon;		// Tracks not yet pushed
+    G4double eElec, eHole, ePhon;	// Kinetic energy of each track
+    G4double chargeWt, phononWt;
+
+    QueuedVertex(const G4ThreeVector& x, G4double t,
+		 const G4LatticePhysical* lat)
+      : pos(x), time(t), lattice(lat), nElec(0), nHole(0), nPhon(0),
+	eElec(0.), eHole(0.), ePhon(0.), chargeWt(1.), phononWt(1.) {;}
+
+    size_t Count() const { return nElec+nHole+nPhon; }
+  };
+
+  void SetQueueEvent(const G4Event* event);	// Discards other events' tracks
+  void QueueVertex(const QueuedVertex& vtx);
+
+  void SetChunkSize(size_t value) { chunkSize = value; }
+  size_t GetChunkSize() const { return chunkSize; }
+  size_t GetNumberQueued() const { return nQueued; }
 
 protected:
+  void PushQueuedTracks();		// Create and stack next chunk
+  G4Track* CreateQueuedTrack(QueuedVertex& vtx) const;
+  void ClearQueue();
+
   void SetPhononVelocity(const G4Track* theTrack) const;
 
   void SetChargeCarrierMass(const G4Track* theTrack) const;
   void SetElectronEnergy(const G4Track* aTrack) const;
 
+protected:
+  std::vector<QueuedVertex> queue;	// Vertices with tracks not yet pushed
+  size_t nextQueued;		// Index of first vertex with tracks left
+  size_t nQueued;		// Total tracks not yet pushed
+  size_t chunkSize;		// Maximum tracks pushed at each stage
+  G4int queueEventID;		// Event to which queued tracks belong
+  G4bool holdingTrack;		// A track is held on waiting stack
+
 public:
   G4CMPStackingAction(const G4CMPStackingAction&) = default;
   G4CMPStackingAction(G4CMPStackingAction&&) = default;
@@ -0,0 +1,54 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPSurfaceData.hh
+/// \brief Definition of the G4CMPSurfaceData container.  Holds the
+///	   boundary parameters for one particle type (charge or phonon)
+///	   from a G4CMPSurfaceProperty, copied from its material properties
+///	   table, along with phonon reflection probabilities tabulated in
+///	   frequency.  Filled by G4CMPSurfaceProperty::UpdateSurfaceData()
+///	   so that boundary processes need no string-keyed lookups.
+//
+// 20261018  New container for compiled surface properties
+// 20261018  Flag whether reflection table was filled (requires specProb)
+
+#ifndef G4CMPSurfaceData_hh
+#define G4CMPSurfaceData_hh 1
+
+#include "globals.hh"
+#include <vector>
+
+
+struct G4CMPSurfaceData {
+  G4CMPSurfaceData()
+    : absProb(0.), reflProb(0.), specProb(0.), absMinK(0.), minKElec(0.),
+      minKHole(0.), reflNodes(0), hasReflection(false) {
+    reflTail[0] = reflTail[1] = reflTail[2] = 0.;
+  }
+
+  G4double absProb;			// Probability to absorb at surface
+  G4double reflProb;			// If not absorbed, probability to reflect
+  G4double specProb;			// Phonon specular reflection (scalar)
+  G4double absMinK;			// Minimum phonon k_perp to absorb
+  G4double minKElec;			// Minimum electron k_perp to absorb
+  G4double minKHole;			// Minimum hole k_perp to absorb
+
+  // Normalized phonon reflection probabilities vs. frequency, as used by
+  // G4CMPPhononBoundaryProcess.  Tabulated in segments between cutoffs,
+  // so that each segment is smooth; values are constant above all cutoffs.
+  // Lookup without "specProb" in the phonon table is a fatal error.
+  enum { kAnharmonic=0, kSpecular, kDiffuse, kNChannels };
+
+  void GetReflectionProbs(G4double freq, G4double& anhProb,
+			  G4double& specProb, G4double& diffProb) const;
+
+  std::vector<G4double> reflEdge;	// Segment boundaries, from zero
+  std::vector<G4double> reflTable;	// [segment][node][channel]
+  G4double reflTail[kNChannels];	// Values above last boundary
+  G4int reflNodes;			// Nodes per segment
+  G4bool hasReflection;			// Probabilities have been filled
+};
+
+#endif	/* G4CMPSurfaceData_hh */
@@ -0,0 +1,83 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPSurfaceLookup.hh
+/// \brief Definition of the G4CMPSurfaceLookup class.  Maps a pair of
+///	   placement volumes directly to the G4CMP surface between them,
+///	   replacing separate searches of the G4CMPLogicalBorderSurface and
+///	   G4CMPLogicalSkinSurface registries with one open-addressing table.
+///
+/// Border surfaces are keyed by (vol1, vol2); skin surfaces are keyed by
+/// (logical volume, null), and are returned for a pair with no border
+/// surface, as in G4CMPBoundaryUtils.  Each entry carries the surface's
+/// G4CMPSurfaceProperty, if any.  Users of an entry should check it against
+/// the surface's current property, which may be replaced between runs.
+///
+/// The table does not modify surface properties.  Their compiled data is
+/// refreshed on the master thread by UpdateSurfaceData(), called from the
+/// boundary processes' BuildPhysicsTable(), before workers share it.
+///
+/// The table is built by the first thread to use it, which is during
+/// tracking when the geometry is closed, and is then read-only and shared
+/// by all threads.  Any change to the surface registries (which must be
+/// made from the master thread, between runs) discards it for rebuilding.
+//
+// 20261018  New shared lookup table for boundary surfaces
+// 20261018  Refresh surface data from master, not from first worker
+
+#ifndef G4CMPSurfaceLookup_hh
+#define G4CMPSurfaceLookup_hh 1
+
+#include "globals.hh"
+#include <atomic>
+#include <vector>
+
+class G4CMPSurfaceProperty;
+class G4LogicalSurface;
+class G4VPhysicalVolume;
+
+
+class G4CMPSurfaceLookup {
+public:
+  struct Entry {
+    Entry() : key1(0), key2(0), surface(0), surfProp(0) {;}
+    const void* key1;			// Null for unused slot
+    const void* key2;
+    G4LogicalSurface* surface;
+    G4CMPSurfaceProperty* surfProp;	// Null if not G4CMP compatible
+  };
+
+  // Shared table, built on first call
+  static const G4CMPSurfaceLookup* GetInstance();
+
+  // Discard table after surface registries change
+  static void Invalidate();
+
+  // Refill compiled data of every registered G4CMP surface (master only)
+  static void UpdateSurfaceData();
+
+  // Border surface between volumes, or skin surface of first; null if none
+  const Entry* Find(const G4VPhysicalVolume* vol1,
+		    const G4VPhysicalVolume* vol2) const;
+
+  size_t GetNumberOfSurfaces() const { return nEntries; }
+
+private:
+  G4CMPSurfaceLookup();
+  ~G4CMPSurfaceLookup() {;}
+
+  void Fill();
+  void Insert(const void* key1, const void* key2, G4LogicalSurface* surface);
+  const Entry* FindKey(const void* key1, const void* key2) const;
+  size_t Hash(const void* key1, const void* key2) const;
+
+  std::vector<Entry> slots;		// Size is power of two
+  size_t mask;				// Size minus one, for wrapping
+  size_t nEntries;
+
+  static std::atomic<G4CMPSurfaceLookup*> theTable;
+};
+
+#endif	/* G4CMPSurfaceLookup_hh */
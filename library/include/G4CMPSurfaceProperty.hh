@@ -11,11 +11,13 @@
 // 20190806  M. Kelsey -- Add local data for frequency-dependent scattering
 //		probabilities, and computation functions.
 // 20200601  G4CMP-206: Need thread-local copies of electrode pointers
+// 20261018  Add compiled G4CMPSurfaceData for boundary processes
 
 #ifndef G4CMPSurfaceProperty_h
 #define G4CMPSurfaceProperty_h 1
 
 #include "G4SurfaceProperty.hh"
+#include "G4CMPSurfaceData.hh"
 #include "G4MaterialPropertiesTable.hh"
 #include <vector>
 #include <map>
@@ -71,6 +73,19 @@ public:
   G4MaterialPropertiesTable
   GetPhononMaterialPropertiesTable() const { return thePhononMatPropTable; }
 
+  // Typed copies of boundary parameters, for use by boundary processes
+  const G4CMPSurfaceData* GetChargeSurfaceData() const {
+    return &theChargeData;
+  }
+
+  const G4CMPSurfaceData* GetPhononSurfaceData() const {
+    return &thePhononData;
+  }
+
+  // Rebuild typed copies from tables; called by all of the functions below
+  // NOTE:  Must be called by user after modifying tables via pointers
+  void UpdateSurfaceData();
+
   // Accessors to fill charge-pair and phonon boundary parameters
   void SetChargeMaterialPropertiesTable(G4MaterialPropertiesTable *mpt);
   void SetPhononMaterialPropertiesTable(G4MaterialPropertiesTable *mpt);
@@ -84,23 +99,33 @@ public:
                                          G4double pSpecProb, G4double pMinK);
 
   // Accessors to fill phonon surface interaction parametrizations
-  void AddSurfaceAnharmonicCutoff(G4double freqMax) { anharmonicMaxFreq = freqMax; }
-  void AddSurfaceDiffuseCutoff(G4double freqDiff) { diffuseMaxFreq = freqDiff; }
+  void AddSurfaceAnharmonicCutoff(G4double freqMax) {
+    anharmonicMaxFreq = freqMax;
+    UpdateSurfaceData();
+  }
+
+  void AddSurfaceDiffuseCutoff(G4double freqDiff) {
+    diffuseMaxFreq = freqDiff;
+    UpdateSurfaceData();
+  }
 
   // For polynomial coeffients, units can be factored out and passed separately
   void AddSurfaceAnharmonicCoeffs(const std::vector<G4double>& coeff,
 				  G4double freqUnits=0.) {
     SaveCoeffs(anharmonicCoeffs, coeff, freqUnits);
+    UpdateSurfaceData();
   }
 
   void AddDiffuseReflectionCoeffs(const std::vector<G4double>& coeff,
 				  G4double freqUnits=0.) {
     SaveCoeffs(diffuseCoeffs, coeff, freqUnits);
+    UpdateSurfaceData();
   }
 
   void AddSpecularReflectionCoeffs(const std::vector<G4double>& coeff,
 				   G4double freqUnits=0.) {
     SaveCoeffs(specularCoeffs, coeff, freqUnits);
+    UpdateSurfaceData();
   }
 
   // Functions to compute reflection probabilities vs. frequency
@@ -134,10 +159,19 @@ protected:
 
   G4double ExpandCoeffsPoly(G4double freq, const std::vector<G4double>& coeff) const;
 
+  void FillSurfaceData(G4MaterialPropertiesTable& propTab,
+		       G4CMPSurfaceData& data) const;
+
+  // Normalized reflection probabilities vs. frequency, for phonon data
+  void FillReflectionTable(G4CMPSurfaceData& data) const;
+
 protected:
   G4MaterialPropertiesTable theChargeMatPropTable;
   G4MaterialPropertiesTable thePhononMatPropTable;
 
+  G4CMPSurfaceData theChargeData;	// Filled from tables above
+  G4CMPSurfaceData thePhononData;
+
   G4CMPVElectrodePattern* theChargeElectrode;
   G4CMPVElectrodePattern* thePhononElectrode;
 
@@ -0,0 +1,62 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPSurfaceTableCache.hh
+/// \brief Definition of the G4CMPSurfaceTableCache template.  Per-thread
+///	   cache of phonon reflection tables, keyed by lattice, phonon mode
+///	   and surface normal (rounded to 1e-6).
+///
+/// Table class T must provide a constructor T(lattice, mode, surfNorm)
+/// and IsValid().  A table is built only once its normal has been seen
+/// several times, and the number of entries is limited, so that curved
+/// surfaces with continuously varying normals do not accumulate tables;
+/// GetTable() returns null in those cases, and the caller should use its
+/// untabulated algorithm.
+//
+// 20261018  New template shared by Lambertian and specular tables
+// 20261018  Cache owns its tables, deleted at end of thread
+
+#ifndef G4CMPSurfaceTableCache_hh
+#define G4CMPSurfaceTableCache_hh 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include <map>
+
+class G4LatticePhysical;
+
+
+template <class T>
+class G4CMPSurfaceTableCache {
+public:
+  static const T* GetTable(const G4LatticePhysical* lat, G4int mode,
+			   const G4ThreeVector& surfNorm);
+
+private:
+  struct Key {
+    const G4LatticePhysical* lattice;
+    G4int mode;
+    long nx, ny, nz;			// Normal components in units of 1e-6
+
+    G4bool operator<(const Key& rhs) const;
+  };
+
+  struct Entry {
+    Entry() : uses(0), table(0) {;}
+    G4int uses;				// Requests before table is built
+    T* table;
+  };
+
+  struct Cache : public std::map<Key, Entry> {
+    ~Cache() { for (auto& it: *this) delete it.second.table; }
+  };
+
+  static const G4int buildAfterUses = 8;	// Skip rarely seen normals
+  static const size_t maxEntries = 1024;	// Limit growth from curved surfaces
+};
+
+#include "G4CMPSurfaceTableCache.icc"
+
+#endif	/* G4CMPSurfaceTableCache_hh */
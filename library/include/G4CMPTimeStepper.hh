@@ -17,6 +17,10 @@
 // 20200426  G4CMP-196: Change "impact" name to "trapIon"
 // 20220730  G4CMP-301: Drop trapping processes, as they have built-in MFPs,
 //		don't need TimeStepper for energy-dependent calculation.
+// 20261018  Add uniformization (majorant rate with thinning) as alternative
+//		to energy-threshold step limits.
+// 20261018  Pass G4CMPRateContext to rate calculations.
+// 20261018  Bound uniformization steps by energy window, not thresholds.
 
 #ifndef G4CMPTimeStepper_h
 #define G4CMPTimeStepper_h 1
@@ -25,6 +29,8 @@
 #include "G4CMPVDriftProcess.hh"
 
 class G4CMPVScatteringRate;
+struct G4CMPRateContext;
+class G4VProcess;
 
 
 class G4CMPTimeStepper : public G4CMPVDriftProcess {
@@ -35,13 +41,12 @@ public:
   // Initialize local pointers to Luke and IV scattering rate models
   virtual void LoadDataForTrack(const G4Track* aTrack);
 
-  // No random throw here: MFP and GPIL are fixed lengths
+  // No random throw here: MFP and GPIL are fixed lengths, except with
+  // uniformization, where the step is drawn from the majorant rate
   virtual G4double 
   PostStepGetPhysicalInteractionLength(const G4Track& aTrack,
 				       G4double prevStepSize,
-				       G4ForceCondition* condition) {
-    return GetMeanFreePath(aTrack, prevStepSize, condition);
-  }
+				       G4ForceCondition* condition);
 
   virtual G4VParticleChange* PostStepDoIt(const G4Track& aTrack,
 					  const G4Step& aStep);
@@ -54,20 +59,40 @@ protected:
   virtual G4double GetMeanFreePath(const G4Track&,G4double,G4ForceCondition*);
 
   // Maximum rate for other processes, given track kinematics
-  G4double MaxRate(const G4Track& aTrack) const;
+  G4double MaxRate(const G4CMPRateContext& ctx) const;
 
   // Step length in E-field needed to reach specified energy
   G4double DistanceToThreshold(const G4CMPVScatteringRate* rate,
 			       G4double Estart) const;
   G4double EnergyStep(G4double Estart, G4double Efinal) const;
 
+  // Shortest step allowed for charge carriers, from minimum step scale
+  G4double MinimumStep() const;
+
   // Get scattering rates for other charge-carrier processes
   void ReportRates(const G4Track& aTrack);
 
+  // Uniformization: exponential step from majorant of Luke and IV rates
+  G4double UniformizedStep(const G4Track& aTrack);
+
+  // Majorant must bound Luke+IV up to highest energy reachable in window
+  G4double MajorantRate(const G4CMPRateContext& ctx, G4double Emax) const;
+  G4double TotalRate(const G4CMPRateContext& ctx) const;
+
+  // Uniformization: thinning test at end of step, pass to selected process
+  G4VParticleChange* ThinningDoIt(const G4Track& aTrack, const G4Step& aStep);
+
   // Pointers may be changed from Use functions
   const G4CMPVScatteringRate* lukeRate;
   const G4CMPVScatteringRate* ivRate;
 
+  // Processes which act on accepted uniformization steps
+  G4VProcess* lukeProc;
+  G4VProcess* ivProc;
+
+  G4double majorant;		// Majorant rate used for most recent step
+  G4bool windowEnd;		// Most recent step ended at energy window
+
 private:
   //hide assignment operator
   G4CMPTimeStepper(G4CMPTimeStepper&);
@@ -0,0 +1,67 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4CMPTrackInfoPool.hh
+/// \brief Definition of the G4CMPTrackInfoPool template.  Per-thread slab
+///	   allocator for auxiliary track information objects.
+///
+/// Track info classes use Allocate() and Free() in their operator new and
+/// operator delete.  Objects are carved from large contiguous slabs, and
+/// freed objects are reused last-in first-out, so repeated creation and
+/// deletion stays in the same few cache lines.  Slabs are never returned
+/// to the system; the pool grows to the peak number of live tracks.
+///
+/// Unlike a global G4Allocator, each thread has its own pool, so there is
+/// no locking and no sharing of free lists between worker threads.  The
+/// pool is created on first use and never deleted, so track info deleted
+/// late in thread shutdown is still valid.  Requests for a size other than
+/// sizeof(T), from subclasses of T, are passed to the global operator new.
+///
+/// NOTE:  An object must be freed on the thread which allocated it.  This
+///	   is the case for tracks, which live within one event.
+//
+// 20261018  New template to replace plain new for track info
+
+#ifndef G4CMPTrackInfoPool_hh
+#define G4CMPTrackInfoPool_hh 1
+
+#include "globals.hh"
+#include <vector>
+
+
+template <class T>
+class G4CMPTrackInfoPool {
+public:
+  static void* Allocate(size_t size);
+  static void Free(void* obj, size_t size);
+
+  // Diagnostics for current thread's pool
+  static size_t GetNumberInUse()    { return Instance().nInUse; }
+  static size_t GetNumberReserved() { return Instance().nReserved; }
+
+private:
+  G4CMPTrackInfoPool() : freeList(0), nInUse(0), nReserved(0) {;}
+  ~G4CMPTrackInfoPool();		// Never called; pools live with thread
+
+  static G4CMPTrackInfoPool<T>& Instance();
+
+  void AddSlab();
+
+  union Slot {				// Free slots hold the list link
+    Slot* next;
+    alignas(T) char storage[sizeof(T)];
+  };
+
+  std::vector<Slot*> slabs;		// Owned blocks of slabSize slots
+  Slot* freeList;			// Most recently freed slot first
+  size_t nInUse;
+  size_t nReserved;
+
+  static const size_t slabSize = 4096;	// Slots per block (not bytes)
+};
+
+#include "G4CMPTrackInfoPool.icc"
+
+#endif	/* G4CMPTrackInfoPool_hh */
@@ -0,0 +1,62 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+// $Id$
+//
+// Exact stepper for charge carriers in a uniform electric field.  Between
+// scatters a carrier in a fixed valley has constant acceleration (q/m)E,
+// with the valley mass tensor applied, so the trajectory is a parabola.
+// Each step is solved analytically for the time corresponding to the
+// requested arc length, and no error estimate is needed.  Selected by
+// G4CMPFieldManager in place of G4ClassicalRK4 for G4UniformElectricField.
+//
+// 20261018  New stepper to avoid RK4 integration in uniform fields
+
+#ifndef G4CMPUniformFieldStepper_hh
+#define G4CMPUniformFieldStepper_hh 1
+
+#include "G4MagIntegratorStepper.hh"
+#include "G4ThreeVector.hh"
+
+class G4CMPEqEMField;
+
+
+class G4CMPUniformFieldStepper : public G4MagIntegratorStepper {
+public:
+  G4CMPUniformFieldStepper(G4CMPEqEMField* eqMotion, G4int nvar=8);
+  virtual ~G4CMPUniformFieldStepper() {;}
+
+  G4CMPUniformFieldStepper(const G4CMPUniformFieldStepper&) = delete;
+  G4CMPUniformFieldStepper& operator=(const G4CMPUniformFieldStepper&) = delete;
+
+  // Propagate yIn along arc length h; yErr is identically zero
+  virtual void Stepper(const G4double yIn[], const G4double dydx[],
+		       G4double h, G4double yOut[], G4double yErr[]);
+
+  // Sagitta of the most recent step
+  virtual G4double DistChord() const { return lastSagitta; }
+
+  // Exact solution; order is only used to adapt steps after errors
+  virtual G4int IntegratorOrder() const { return 1; }
+
+protected:
+  // Elapsed time for path length s, starting with v0 and acceleration a
+  G4double TimeForArcLength(const G4ThreeVector& v0, const G4ThreeVector& a,
+			    G4double s) const;
+
+  // Path length traversed in time t (closed form)
+  G4double ArcLength(const G4ThreeVector& v0, const G4ThreeVector& a,
+		     G4double t) const;
+
+private:
+  G4CMPEqEMField* theEqMotion;		// Same as base, with G4CMP interface
+  G4double lastSagitta;
+
+  // Buffers to avoid memory churn
+  G4double point[4];
+  G4double field[6];
+};
+
+#endif	/* G4CMPUniformFieldStepper_hh */
@@ -16,6 +16,8 @@
 // 20190906  Add function to get process associated with particle
 // 20220816  Move RandomIndex function from SecondaryProduction
 // 20220921  G4CMP-319 -- Add utilities for thermal (Maxwellian) distributions
+// 20261018  Add LambertReflection for phonon mode, using tabulated envelope
+// 20261018  Move ChargeCarrierTimeStep here, taking lattice as argument
 
 #ifndef G4CMPUtils_hh
 #define G4CMPUtils_hh 1
@@ -76,6 +78,10 @@ namespace G4CMP {
   // Phonons reflect difusively from surfaces.
   G4ThreeVector LambertReflection(const G4ThreeVector& surfNorm);
 
+  // Diffuse reflection restricted to inward group velocity for phonon mode
+  G4ThreeVector LambertReflection(const G4LatticePhysical* lattice, G4int mode,
+				  const G4ThreeVector& surfNorm);
+
   // Test that a phonon's wave vector relates to an inward velocity.
   G4bool PhononVelocityIsInward(const G4LatticePhysical* lattice, G4int mode,
                                 const G4ThreeVector& waveVector,
@@ -92,6 +98,11 @@ namespace G4CMP {
   G4bool IsThermalized(const G4Track* track);
   inline G4bool IsThermalized(const G4Track& t) { return IsThermalized(&t); }
 
+  // Time between scatters/emissions for moving charge carrier, from "Mach
+  // number" (ratio to sound speed) and scattering length
+  G4double ChargeCarrierTimeStep(const G4LatticePhysical* lattice,
+				 G4double mach, G4double l0);
+
   // Search particle's processes for specified name
   G4VProcess* FindProcess(const G4ParticleDefinition* pd, const G4String& pname);
 
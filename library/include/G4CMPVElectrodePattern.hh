@@ -14,6 +14,9 @@
 // 20170525  M. Kelsey -- Add "rule of five" default copy/move operators
 // 20170627  M. Kelsey -- Inherit from G4CMPProcessUtils
 // 20200601  G4CMP-207: Require Clone() functions from sublcasses for copying
+// 20261018  Allow subclasses to configure themselves from surface table;
+//		initialize table pointer.
+// 20261018  Add notification that surface table contents have changed.
 
 #ifndef G4CMPVElectrodePattern_h
 #define G4CMPVElectrodePattern_h 1
@@ -30,7 +33,7 @@ class G4Track;
 
 class G4CMPVElectrodePattern : public G4CMPProcessUtils {
 public:
-  G4CMPVElectrodePattern() : verboseLevel(0) {;}
+  G4CMPVElectrodePattern() : verboseLevel(0), theSurfaceTable(0) {;}
   virtual ~G4CMPVElectrodePattern() {;}
 
   // Use default copy/move operators
@@ -49,10 +52,15 @@ public:
   void SetVerboseLevel(G4int vb) { verboseLevel = vb; }
 
   // Local copy of properties stored automatically by G4CMPSurfaceProperty
-  void UseSurfaceTable(G4MaterialPropertiesTable* surfProp) {
+  // Subclasses may override to initialize, but must call back here
+  virtual void UseSurfaceTable(G4MaterialPropertiesTable* surfProp) {
     theSurfaceTable = surfProp;
   }
 
+  // Called by G4CMPSurfaceProperty when table contents have been refilled
+  // Subclasses which cache table values should discard them here
+  virtual void SurfaceTableUpdated() {;}
+
   // Subclass MUST implement this to return true/false depending on position
   virtual G4bool IsNearElectrode(const G4Step& aStep) const = 0;
 
@@ -10,10 +10,13 @@
 ///	   provides an interface to implement calculations of scattering
 ///	   rate (either phenomenological or theoretical) for phonons or
 ///	   charge carriers.  Subclasses may specified ctor argument if
-///	   process should be forced.
+///	   process should be forced, and which G4CMPRateContext contents
+///	   (energy, wavevectors, electric field) are needed.
 //
 // 20170815  Inherit from G4CMPProcessUtils here, instead of in subclasses
 // 20170919  Add "threshold finder" interface, for use with IV and Luke
+// 20261018  Compute rates from G4CMPRateContext, filled once by process
+// 20261018  Replace electric field flag with mask of context contents
 
 #ifndef G4CMPVScatteringRate_hh
 #define G4CMPVScatteringRate_hh 1
@@ -21,23 +24,30 @@
 #include "globals.hh"
 #include "G4CMPConfigManager.hh"
 #include "G4CMPProcessUtils.hh"
+#include "G4CMPRateContext.hh"
 
 class G4Track;
 
 
 class G4CMPVScatteringRate : public G4CMPProcessUtils {
 public:
-  G4CMPVScatteringRate(const G4String& theName, G4bool force=false)
+  G4CMPVScatteringRate(const G4String& theName, G4bool force=false,
+		       G4int needs=G4CMPRateContext::All)
     : G4CMPProcessUtils(),
       verboseLevel(G4CMPConfigManager::GetVerboseLevel()),
-      name(theName), isForced(force) {;}
+      name(theName), isForced(force), contextNeeds(needs) {;}
 
   virtual ~G4CMPVScatteringRate() {;}
 
-  // Get scattering rate from track kinematics; subclasses MUST IMPLEMENT
-  virtual G4double Rate(const G4Track& aTrack) const = 0;
+  // Get scattering rate from step kinematics; subclasses MUST IMPLEMENT
+  // NOTE:  Rate must depend only on context, not on local track data
+  virtual G4double Rate(const G4CMPRateContext& ctx) const = 0;
+
+  // Additional interfaces which call back to above; should not be overridden
+  G4double Rate(const G4Track& aTrack) const {
+    return Rate(MakeRateContext(aTrack, contextNeeds));
+  }
 
-  // Additional interface which call back to above; should not be overridden
   G4double Rate(const G4Track* aTrack) const { return Rate(*aTrack); }
 
   // Interface to identify energy thresholds (for IV, Luke subclasses)
@@ -47,6 +57,12 @@ public:
 
   G4bool IsForced() { return isForced; }
 
+  // Contents which context must include (subclasses should set mask)
+  G4int GetContextNeeds() const { return contextNeeds; }
+  G4bool NeedsField() const {
+    return (contextNeeds & G4CMPRateContext::Field) != 0;
+  }
+
   // General configuration
   void SetVerboseLevel(G4int vb) { verboseLevel = vb; }
   G4int GetVerboseLevel() const { return verboseLevel; }
@@ -57,6 +73,7 @@ protected:
   G4int verboseLevel;		// Accessible for use by subclasses
   G4String name;		// For diagnostic output if desired
   G4bool isForced;		// Flag 'true' if process should be forced
+  G4int contextNeeds;		// G4CMPRateContext::Contents used by Rate()
 };
 
 #endif	/* G4CMPVScatteringRate_hh */
@@ -38,12 +38,16 @@
 //		precompute valley inverse transforms
 // 20200608  Fix -Wshadow warnings from tempvec
 // 20210919  M. Kelsey -- Allow SetVerboseLevel() from const instances.
+// 20261018  Add precomputed intervalley rate constants, filled by Initialize()
+// 20261018  Refill intervalley rate constants when IV parameters are set
+// 20261018  Also refill IV constants for density, permittivity, mass, valleys
 
 #ifndef G4LatticeLogical_h
 #define G4LatticeLogical_h
 
 #include "globals.hh"
 #include "G4CMPCrystalGroup.hh"
+#include "G4CMPIVRateData.hh"
 #include "G4ThreeVector.hh"
 #include "G4RotationMatrix.hh"
 #include "G4PhononPolarization.hh"
@@ -120,13 +124,13 @@ public:
   }
 
   // Physical parameters of lattice (density, elasticity)
-  void SetDensity(G4double val) { fDensity = val; }
+  void SetDensity(G4double val) { fDensity = val; UpdateIVRateData(); }
   G4double GetDensity() const { return fDensity; }
 
-  void SetImpurities(G4double val) { fNImpurity = val; }
+  void SetImpurities(G4double val) { fNImpurity = val; UpdateIVRateData(); }
   G4double GetImpurities() const { return fNImpurity; }
 
-  void SetPermittivity(G4double val) { fPermittivity = val; }
+  void SetPermittivity(G4double val) { fPermittivity = val; UpdateIVRateData(); }
   G4double GetPermittivity() const { return fPermittivity; }
 
   const Elasticity& GetElasticity() const { return fElasticity; }
@@ -209,6 +213,7 @@ public:
   void AddValley(G4double phi, G4double theta, G4double psi);
   void ClearValleys() {
     fValley.clear(); fValleyInv.clear();fValleyAxis.clear();
+    UpdateIVRateData();
   }
 
   size_t NumberOfValleys() const { return fValley.size(); }
@@ -232,18 +237,22 @@ public:
   // Parameters for electron intervalley scattering (Edelweiss, Linear, matrix)
   void SetIVModel(const G4String& v) { fIVModel = v; }
 
-  void SetIVQuadField(G4double v)    { fIVQuadField = v; }
-  void SetIVQuadRate(G4double v)     { fIVQuadRate = v; }
-  void SetIVQuadExponent(G4double v) { fIVQuadExponent = v; }
+  void SetIVQuadField(G4double v)    { fIVQuadField = v; UpdateIVRateData(); }
+  void SetIVQuadRate(G4double v)     { fIVQuadRate = v; UpdateIVRateData(); }
+  void SetIVQuadExponent(G4double v) { fIVQuadExponent = v; UpdateIVRateData(); }
 
-  void SetIVLinRate0(G4double v)     { fIVLinRate0 = v; }
-  void SetIVLinRate1(G4double v)     { fIVLinRate1 = v; }
-  void SetIVLinExponent(G4double v)  { fIVLinExponent = v; }
+  void SetIVLinRate0(G4double v)     { fIVLinRate0 = v; UpdateIVRateData(); }
+  void SetIVLinRate1(G4double v)     { fIVLinRate1 = v; UpdateIVRateData(); }
+  void SetIVLinExponent(G4double v)  { fIVLinExponent = v; UpdateIVRateData(); }
 
-  void SetAlpha(G4double v)	     { fAlpha = v; }
+  void SetAlpha(G4double v)	     { fAlpha = v; UpdateIVRateData(); }
   void SetAcousticDeform(G4double v) { fAcDeform = v; }
-  void SetIVDeform(const std::vector<G4double>& vlist) { fIVDeform = vlist; }
-  void SetIVEnergy(const std::vector<G4double>& vlist) { fIVEnergy = vlist; }
+  void SetIVDeform(const std::vector<G4double>& vlist) {
+    fIVDeform = vlist; UpdateIVRateData();
+  }
+  void SetIVEnergy(const std::vector<G4double>& vlist) {
+    fIVEnergy = vlist; UpdateIVRateData();
+  }
 
   const G4String& GetIVModel() const { return fIVModel; }
 
@@ -267,11 +276,17 @@ public:
     return (i>=0 && i<GetNIVDeform()) ? fIVEnergy[i] : 0.;
   }
 
+  // Sorted thresholds and unitless constants for IV rate models; filled by
+  // Initialize(), and refilled by the IV parameter setters after that
+  const G4CMPIVRateData& GetIVRateData() const { return fIVRateData; }
+
 private:
   void CheckBasis();	// Initialize or complete (via cross) basis vectors
   void FillElasticity();	// Unpack reduced Cij into full Cijlk
   void FillMaps();	// Populate lookup tables using kinematics calculator
   void FillMassInfo();	// Called from SetMassTensor() to compute derived forms
+  void FillIVRateData();	// Precompute IV rate constants from parameters
+  void UpdateIVRateData() { if (fHasIVRateData) FillIVRateData(); }
 
   // Get theta, phi bins and offsets for interpolation
   G4bool FindLookupBins(const G4ThreeVector& k, G4int& iTheta, G4int& iPhi,
@@ -352,6 +367,9 @@ private:
   G4double fIVLinRate1;		 // Linear rate for linear scaled IV scat.
 
   G4String fIVModel;		 // Name of IV rate function to be used
+
+  G4CMPIVRateData fIVRateData;	 // Derived constants for IV rate models
+  G4bool fHasIVRateData;	 // Constants filled (by Initialize())
 };
 
 // Write lattice structure to output stream
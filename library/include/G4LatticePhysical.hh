@@ -36,6 +36,7 @@
 // 20210919  M. Kelsey -- Allow SetVerboseLevel() from const instances.
 // 20220921  G4CMP-319 -- Add utilities for thermal (Maxwellian) distributions
 //		Also, add long missing accessors for Miller orientation
+// 20261018  Add access to precomputed IV rate constants
 
 #ifndef G4LatticePhysical_h
 #define G4LatticePhysical_h 1
@@ -182,6 +183,8 @@ public:
   const std::vector<G4double>& GetIVDeform() const { return fLattice->GetIVDeform(); }
   const std::vector<G4double>& GetIVEnergy() const { return fLattice->GetIVEnergy(); }
 
+  const G4CMPIVRateData& GetIVRateData() const { return fLattice->GetIVRateData(); }
+
   // Dump logical lattice, with additional info about physical
   void Dump(std::ostream& os) const;
 
@@ -0,0 +1,87 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/include/G4PhononScatteringAndDecay.hh
+/// \brief Definition of the G4PhononScatteringAndDecay class.  Combined
+///	   bulk phonon process for isotope scattering and anharmonic decay,
+///	   replacing separate G4PhononScattering and G4PhononDownconversion
+///	   processes.
+///
+///	   Each channel has its own rate model (channelModel[]; by default
+///	   G4CMPPhononScatteringRate and G4CMPDownconversionRate), which may
+///	   be replaced by the user.  GetMeanFreePath() sums the rates of the
+///	   enabled channels to draw a single interaction length, and the
+///	   channel is chosen at the end of the step from the stored rates.
+///	   Channels may be disabled with /g4cmp/enablePhononScattering and
+///	   /g4cmp/enablePhononDecay.
+//
+// 20261018  New process to reduce per-step overhead of separate phonon MFPs
+// 20261018  Use channel rate models; allow channels to be disabled
+// 20261018  Describe per-channel rate models in class documentation
+
+#ifndef G4PhononScatteringAndDecay_h
+#define G4PhononScatteringAndDecay_h 1
+
+#include "G4VPhononProcess.hh"
+
+class G4CMPAnharmonicDecay;
+class G4CMPVScatteringRate;
+
+
+class G4PhononScatteringAndDecay : public G4VPhononProcess {
+public:
+  G4PhononScatteringAndDecay(const G4String& name="phononScatteringAndDecay");
+  virtual ~G4PhononScatteringAndDecay();
+
+  // Pass verbosity through to decay utility
+  virtual void SetVerboseLevel(G4int vb);
+
+  // Configure for current track including AnharmonicDecay utility
+  virtual void LoadDataForTrack(const G4Track* track);
+  virtual void EndTracking();
+
+  virtual G4VParticleChange* PostStepDoIt(const G4Track&, const G4Step&);
+
+  // Replace rate model for each channel
+  // NOTE:  Takes ownership of model for deletion; deletes any previous version
+  void UseScatteringRateModel(G4CMPVScatteringRate* model);
+  void UseDownconversionRateModel(G4CMPVScatteringRate* model);
+
+  const G4CMPVScatteringRate* GetScatteringRateModel() const {
+    return channelModel[kScattering];
+  }
+
+  const G4CMPVScatteringRate* GetDownconversionRateModel() const {
+    return channelModel[kDownconversion];
+  }
+
+protected:
+  virtual G4double GetMeanFreePath(const G4Track&, G4double, G4ForceCondition*);
+
+  // Channel actions, selected in PostStepDoIt
+  G4VParticleChange* DoScattering(const G4Track& aTrack);
+  G4VParticleChange* DoDownconversion(const G4Track& aTrack,
+				      const G4Step& aStep);
+
+  // Rates for each channel, filled with MFP for use at end of step
+  enum { kScattering=0, kDownconversion, kNChannels };
+  G4CMPVScatteringRate* channelModel[kNChannels];
+  G4double channelRate[kNChannels];
+  G4double totalRate;
+
+  void UseChannelRateModel(G4int channel, G4CMPVScatteringRate* model);
+  void ConfigureChannelModels();
+
+private:
+  G4CMPAnharmonicDecay* anharmonicDecay;
+
+  // No copying/moving
+  G4PhononScatteringAndDecay(G4PhononScatteringAndDecay&);
+  G4PhononScatteringAndDecay(G4PhononScatteringAndDecay&&);
+  G4PhononScatteringAndDecay& operator=(const G4PhononScatteringAndDecay&);
+  G4PhononScatteringAndDecay& operator=(const G4PhononScatteringAndDecay&&);
+};
+
+#endif	/* G4PhononScatteringAndDecay_h */
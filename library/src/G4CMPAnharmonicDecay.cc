@@ -7,6 +7,8 @@
 // 20220907  G4CMP-316 -- Pass track into CreatePhonon instead of touchable.
 //		Check for null pointers from secondaries.
 // 20220914  G4CMP-322 -- Address compiler warnings for unused arguments.
+// 20261018  Replace rejection sampling of daughter energy fractions with
+//		inverse-CDF tables, filled once for each lattice.
 
 #include "G4CMPAnharmonicDecay.hh"
 #include "G4CMPPhononTrackInfo.hh"
@@ -15,6 +17,7 @@
 #include "G4CMPUtils.hh"
 #include "G4Exception.hh"
 #include "G4ExceptionSeverity.hh"
+#include "G4LatticeLogical.hh"
 #include "G4LatticePhysical.hh"
 #include "G4ParticleChange.hh"
 #include "G4PhononLong.hh"
@@ -25,12 +28,43 @@
 #include "G4SystemOfUnits.hh"
 #include "G4VProcess.hh"
 #include "Randomize.hh"
+#include <algorithm>
 #include <cmath>
 
+
+// Energy fraction densities on u in [0,1], mapped onto the same ranges and
+// truncated at the same bounds as the previous rejection sampling
+
+struct G4CMPAnharmonicDecay::TTShape {
+  TTShape(const G4CMPAnharmonicDecay* theDecay) : decay(theDecay) {;}
+
+  G4double operator()(G4double /*par*/, G4double u) const {
+    const G4double d = decay->fvLvT;
+    G4double x = 0.5*(1.-1./d) + u/d;
+    return std::min(decay->GetTTDecayProb(d, x*d), 1.5);
+  }
+
+  const G4CMPAnharmonicDecay* decay;
+};
+
+struct G4CMPAnharmonicDecay::LTShape {
+  LTShape(const G4CMPAnharmonicDecay* theDecay) : decay(theDecay) {;}
+
+  G4double operator()(G4double /*par*/, G4double u) const {
+    const G4double d = decay->fvLvT;
+    const G4double range = 2./(d+1.);
+    G4double x = (d-1.)/(d+1.) + u*range;
+    return std::min(decay->GetLTDecayProb(d, x)*range/2.8, 1.);
+  }
+
+  const G4CMPAnharmonicDecay* decay;
+};
+
+
 G4CMPAnharmonicDecay::G4CMPAnharmonicDecay(const G4VProcess* theProcess)
   : verboseLevel(theProcess?theProcess->GetVerboseLevel():0),
     procName(theProcess?theProcess->GetProcessName():"G4CMPAnharmonicDecay"),
-    fBeta(0.), fGamma(0.), fLambda(0.), fMu(0.), fvLvT(1.) {;}
+    fBeta(0.), fGamma(0.), fLambda(0.), fMu(0.), fvLvT(1.), fTables(0) {;}
 
 void G4CMPAnharmonicDecay::DoDecay(const G4Track& aTrack, const G4Step&,
 				   G4ParticleChange& aParticleChange) {
@@ -53,6 +87,7 @@ void G4CMPAnharmonicDecay::DoDecay(const G4Track& aTrack, const G4Step&,
   fMu     = theLattice->GetMu() / (1e11*pascal);
 
   fvLvT = theLattice->GetSoundSpeed() / theLattice->GetTransverseSoundSpeed();
+  fTables = &GetDecayTables();
 
   //Destroy the parent phonon and create the daughter phonons.
   //74% chance that daughter phonons are both transverse
@@ -89,6 +124,28 @@ void G4CMPAnharmonicDecay::DoDecay(const G4Track& aTrack, const G4Step&,
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
+// Tables depend only on lattice constants, so are filled once per lattice
+
+const G4CMPAnharmonicDecay::DecayTables&
+G4CMPAnharmonicDecay::GetDecayTables() {
+  const G4LatticeLogical* lattice = theLattice->GetLattice();
+
+  std::map<const G4LatticeLogical*, DecayTables>::iterator it =
+    decayTables.find(lattice);
+  if (it != decayTables.end()) return it->second;
+
+  if (verboseLevel) {
+    G4cout << procName << " filling anharmonic decay tables, vL/vT "
+	   << fvLvT << G4endl;
+  }
+
+  DecayTables& tables = decayTables[lattice];
+  tables.tt.Initialize(TTShape(this), 0., 0., 1);
+  tables.lt.Initialize(LTShape(this), 0., 0., 1);
+
+  return tables;
+}
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
 //probability density of energy distribution of L'-phonon in L->L'+T process
@@ -146,16 +203,10 @@ MakeTTSecondaries(const G4Track& aTrack, G4ParticleChange& aParticleChange) {
   G4double upperBound=(1+(1/fvLvT))/2;
   G4double lowerBound=(1-(1/fvLvT))/2;
 
-  //Use MC method to generate point from distribution:
-  //if a random point on the energy-probability plane is
-  //smaller that the curve of the probability density,
-  //then accept that point.
+  //Sample tabulated inverse CDF of probability density (see TTShape)
   //x=fraction of parent phonon energy in first T phonon
-  G4double x=0, p=0;
-  do {
-    x = G4UniformRand()*(upperBound-lowerBound) + lowerBound;
-    p = 1.5*G4UniformRand();
-  } while (p >= GetTTDecayProb(fvLvT, x*fvLvT));
+  G4double x = lowerBound
+    + fTables->tt.Sample(G4UniformRand())*(upperBound-lowerBound);
 
 
   //using energy fraction x to calculate daughter phonon directions
@@ -235,11 +286,10 @@ MakeLTSecondaries(const G4Track& aTrack, G4ParticleChange& aParticleChange) {
   G4double upperBound=1;
   G4double lowerBound=(fvLvT-1)/(fvLvT+1);
 
-  G4double u=0, x=0;
-  do {
-    u = G4UniformRand();
-    x = G4UniformRand()*(upperBound-lowerBound) + lowerBound;
-  } while (u >= GetLTDecayProb(fvLvT, x)/(2.8/(upperBound-lowerBound)));
+  //Sample tabulated inverse CDF of probability density (see LTShape)
+  //x=fraction of parent phonon energy in L' phonon
+  G4double x = lowerBound
+    + fTables->lt.Sample(G4UniformRand())*(upperBound-lowerBound);
 
 
   //using energy fraction x to calculate daughter phonon directions
@@ -24,14 +24,16 @@
 //	     to electrode.
 // 20210923  Use >= in maximum reflections check.
 // 20211207  Replace G4Logical*Surface with G4CMP-specific versions.
+// 20261018  Use typed G4CMPSurfaceData for absorption and reflection.
+// 20261018  Find surfaces via shared G4CMPSurfaceLookup table.
+// 20261018  Use surface's current property if it differs from lookup entry.
 
 #include "G4CMPBoundaryUtils.hh"
 #include "G4CMPConfigManager.hh"
 #include "G4CMPGeometryUtils.hh"
-#include "G4CMPLogicalBorderSurface.hh"
-#include "G4CMPLogicalSkinSurface.hh"
 #include "G4CMPSurfaceProperty.hh"
 #include "G4CMPProcessUtils.hh"
+#include "G4CMPSurfaceLookup.hh"
 #include "G4CMPVTrackInfo.hh"
 #include "G4CMPTrackUtils.hh"
 #include "G4CMPUtils.hh"
@@ -58,7 +60,7 @@ G4CMPBoundaryUtils::G4CMPBoundaryUtils(G4VProcess* process)
     procName(process->GetProcessName()), procUtils(0),
     kCarTolerance(G4GeometryTolerance::GetInstance()->GetSurfaceTolerance()),
     maximumReflections(-1), prePV(0), postPV(0), surfProp(0), matTable(0),
-    electrode(0) {
+    surfData(0), electrode(0) {
   procUtils = dynamic_cast<G4CMPProcessUtils*>(process);
   if (!procUtils) {
     G4Exception("G4CMPBoundaryUtils::G4CMPBoundaryUtils", "Boundary000",
@@ -134,30 +136,30 @@ G4bool G4CMPBoundaryUtils::GetBoundingVolumes(const G4Step& aStep) {
 G4bool G4CMPBoundaryUtils::GetSurfaceProperty(const G4Step& aStep) {
   surfProp = nullptr;				// Avoid stale cache!
   matTable = nullptr;
+  surfData = nullptr;
   electrode = nullptr;
   
-  // Look for specific surface between pre- and post-step points first
-  G4LogicalSurface* surface =
-    G4CMPLogicalBorderSurface::GetSurface(prePV, postPV);
-  if (!surface) {			// Then for generic pre-setp surface
-    surface = G4CMPLogicalSkinSurface::GetSurface(prePV->GetLogicalVolume());
-  }
-
-  BoundaryPV bound(prePV,postPV);	// Avoid multiple temporaries below
+  // Specific surface between pre- and post-step points, or generic
+  // pre-step surface, from table shared by all threads
+  const G4CMPSurfaceLookup::Entry* entry =
+    G4CMPSurfaceLookup::GetInstance()->Find(prePV, postPV);
+  G4LogicalSurface* surface = entry ? entry->surface : 0;
+
+  if (!surface) {
+    BoundaryPV bound(prePV,postPV);	// Avoid multiple temporaries below
+
+    // Report missing surface once per boundary
+    if (hasSurface.find(bound) == hasSurface.end()) {
+      G4Exception((procName+"::GetSurfaceProperty").c_str(), "Boundary001",
+		  JustWarning, ("No surface defined between " +
+				prePV->GetName() + " and " +
+				postPV->GetName()).c_str());
+    }
 
-  // Report missing surface once per boundary
-  if ((hasSurface.find(bound) == hasSurface.end())
-      && !surface) {
-    G4Exception((procName+"::GetSurfaceProperty").c_str(), "Boundary001",
-                JustWarning, ("No surface defined between " +
-			      prePV->GetName() + " and " +
-			      postPV->GetName()).c_str());
+    hasSurface[bound] = false;		// Remember this boundary
+    return true;			// Can handle undefined surfaces
   }
 
-  hasSurface[bound] = false;		// Remember this boundary
-
-  if (!surface) return true;			// Can handle undefined surfaces
-
   G4SurfaceProperty* baseSP = surface->GetSurfaceProperty();
   if (!baseSP) {
     G4Exception((procName+"::GetSurfaceProperty").c_str(),
@@ -167,8 +169,10 @@ G4bool G4CMPBoundaryUtils::GetSurfaceProperty(const G4Step& aStep) {
     return true;			// Can handle undefined surfaces
   }
 
-  // Verify that surface property is G4CMP compatible
-  surfProp = dynamic_cast<G4CMPSurfaceProperty*>(baseSP);
+  // Verify that surface property is G4CMP compatible; property may have
+  // been replaced since lookup table was filled
+  surfProp = (baseSP == entry->surfProp ? entry->surfProp
+	      : dynamic_cast<G4CMPSurfaceProperty*>(baseSP));
   if (!surfProp) {
     G4Exception((procName+"::GetSurfaceProperty").c_str(),
 		"Boundary003", EventMustBeAborted,
@@ -180,11 +184,13 @@ G4bool G4CMPBoundaryUtils::GetSurfaceProperty(const G4Step& aStep) {
   const G4ParticleDefinition* pd = aStep.GetTrack()->GetParticleDefinition();
   if (G4CMP::IsChargeCarrier(pd)) {
     matTable = surfProp->GetChargeMaterialPropertiesTablePointer();
+    surfData = surfProp->GetChargeSurfaceData();
     electrode = surfProp->GetChargeElectrode();
   }
 
   if (G4CMP::IsPhonon(pd)) {
     matTable = surfProp->GetPhononMaterialPropertiesTablePointer();
+    surfData = surfProp->GetPhononSurfaceData();
     electrode = surfProp->GetPhononElectrode();
   }
 
@@ -202,8 +208,6 @@ G4bool G4CMPBoundaryUtils::GetSurfaceProperty(const G4Step& aStep) {
     electrode->LoadDataForTrack(aStep.GetTrack());
   }
 
-  hasSurface[bound] = true;		// Record good surface defined
-
   return true;
 }
 
@@ -292,7 +296,7 @@ G4CMPBoundaryUtils::ApplyBoundaryAction(const G4Track& aTrack,
 // Default conditions for absorption or reflection
 
 G4bool G4CMPBoundaryUtils::AbsorbTrack(const G4Track&, const G4Step&) const {
-  G4double absProb = GetMaterialProperty("absProb");
+  G4double absProb = surfData->absProb;
   if (buVerboseLevel>2)
     G4cout << " AbsorbTrack: absProb " << absProb << G4endl;
 
@@ -300,7 +304,7 @@ G4bool G4CMPBoundaryUtils::AbsorbTrack(const G4Track&, const G4Step&) const {
 }
 
 G4bool G4CMPBoundaryUtils::ReflectTrack(const G4Track&, const G4Step&) const {
-  G4double reflProb = GetMaterialProperty("reflProb");
+  G4double reflProb = surfData->reflProb;
   if (buVerboseLevel>2)
     G4cout << " ReflectTrack: reflProb " << reflProb << G4endl;
 
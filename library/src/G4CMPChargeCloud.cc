@@ -12,19 +12,27 @@
 ///   sphere will be "folded" inward at bounding surfaces.
 ///
 // $Id$
+//
+// 20261018  Generate points in batch, with analytic G4Box/G4Tubs folding
 
 #include "G4CMPChargeCloud.hh"
 #include "G4CMPGeometryUtils.hh"
+#include "G4CMPGlobalLocalTransformStore.hh"
+#include "G4Box.hh"
+#include "G4GeometryTolerance.hh"
 #include "G4LatticeLogical.hh"
 #include "G4LatticeManager.hh"
 #include "G4LatticePhysical.hh"
 #include "G4LogicalVolume.hh"
+#include "G4PhysicalConstants.hh"
 #include "G4RandomDirection.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Tubs.hh"
 #include "G4VPhysicalVolume.hh"
 #include "G4VSolid.hh"
 #include "G4VTouchable.hh"
 #include "Randomize.hh"
+#include <algorithm>
 #include <math.h>
 
 
@@ -33,8 +41,11 @@
 G4CMPChargeCloud::G4CMPChargeCloud(const G4LatticeLogical* lat,
 				   const G4VSolid* solid)
   : verboseLevel(0), theLattice(0), theSolid(solid), theTouchable(nullptr),
-    avgLatticeSpacing(0.), radiusScale(0.), binSpacing(0.), cloudRadius(0.) {
+    avgLatticeSpacing(0.), radiusScale(0.), binSpacing(0.),
+    shapeType(kNoShape), halfX(0.), halfY(0.), halfZ(0.), innerR(0.),
+    outerR(0.), halfTolerance(0.), cloudRadius(0.) {
   SetLattice(lat);
+  CacheShape();
 }
 
 G4CMPChargeCloud::G4CMPChargeCloud(const G4LatticePhysical* lat,
@@ -85,6 +96,46 @@ void G4CMPChargeCloud::SetTouchable(const G4VTouchable* touch) {
 }
 
 
+// Store shape, and parameters for analytic folding if available
+
+void G4CMPChargeCloud::SetShape(const G4VSolid* solid) {
+  theSolid = solid;
+  CacheShape();
+}
+
+void G4CMPChargeCloud::CacheShape() {
+  shapeType = theSolid ? kGenericShape : kNoShape;
+  halfX = halfY = halfZ = innerR = outerR = 0.;
+  if (!theSolid) return;
+
+  halfTolerance =
+    0.5*G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
+
+  G4GeometryType type = theSolid->GetEntityType();
+  if (type == "G4Box") {
+    const G4Box* box = static_cast<const G4Box*>(theSolid);
+    halfX = box->GetXHalfLength();
+    halfY = box->GetYHalfLength();
+    halfZ = box->GetZHalfLength();
+    shapeType = kBoxShape;
+  } else if (type == "G4Tubs") {
+    const G4Tubs* tubs = static_cast<const G4Tubs*>(theSolid);
+    if (tubs->GetDeltaPhiAngle() >= twopi) {	// Segments have phi surfaces
+      innerR = tubs->GetInnerRadius();
+      outerR = tubs->GetOuterRadius();
+      halfZ = tubs->GetZHalfLength();
+      shapeType = kTubsShape;
+    }
+  }
+
+  if (verboseLevel>1) {
+    G4cout << "G4CMPChargeCloud shape " << type
+	   << (shapeType==kGenericShape ? " (generic)" : " (analytic)")
+	   << G4endl;
+  }
+}
+
+
 // Extract shape from placement volume
 
 void G4CMPChargeCloud::UseVolume(const G4VPhysicalVolume* vol) {
@@ -111,20 +162,25 @@ G4CMPChargeCloud::Generate(G4int npos, const G4ThreeVector& center) {
 	   << binSpacing/nm << " nm" << G4endl;
   }
 
+  GeneratePoints(npos, cloudRadius);
+  if (theSolid) FoldToShape();			// Checkout boundaries
+
   theCloud.clear();
   theCloud.reserve(npos);
 
   theCloudBins.clear();
   theCloudBins.reserve(npos);
 
-  for (G4int i=0; i<npos; i++) {
-    theCloud.push_back(GeneratePoint(cloudRadius)+localCenter);
-    if (theSolid) AdjustToVolume(theCloud.back());	// Checkout boundaries
+  // Same transform for all points
+  const G4AffineTransform* toGlobal = 0;
+  if (theTouchable)
+    toGlobal = &G4CMPGlobalLocalTransformStore::ToGlobal(theTouchable);
 
+  for (G4int i=0; i<npos; i++) {
+    theCloud.push_back(G4ThreeVector(pointX[i], pointY[i], pointZ[i]));
     theCloudBins.push_back(GetBinIndex(theCloud.back()));
 
-    if (theTouchable)
-      G4CMP::RotateToGlobalPosition(theTouchable, theCloud.back());
+    if (toGlobal) toGlobal->ApplyPointTransform(theCloud.back());
 
     if (verboseLevel>2) {
       G4cout << " point " << i << " @ " << theCloud.back() << " in bin "
@@ -162,6 +218,92 @@ G4ThreeVector G4CMPChargeCloud::GeneratePoint(G4double rmax) const {
 }
 
 
+// Generate all points, using one block of random numbers; same
+// distribution as GeneratePoint(), offset to local center
+
+void G4CMPChargeCloud::GeneratePoints(G4int npos, G4double rmax) {
+  pointX.resize(npos);
+  pointY.resize(npos);
+  pointZ.resize(npos);
+  if (npos <= 0) return;
+
+  randoms.resize(3*npos);		// Radius, cos(theta), phi for each
+  CLHEP::HepRandom::getTheEngine()->flatArray(3*npos, randoms.data());
+
+  for (G4int i=0; i<npos; i++) {
+    const G4double* rndm = &randoms[3*i];
+
+    G4double r = rmax*(1.-sqrt(1.-rndm[0]*rndm[0]));	// Linear from 0 to rmax
+    G4double cosTheta = 2.*rndm[1] - 1.;
+    G4double rsinTheta = r*sqrt(std::max(0., 1.-cosTheta*cosTheta));
+    G4double phi = twopi*rndm[2];
+
+    pointX[i] = localCenter.x() + rsinTheta*cos(phi);
+    pointY[i] = localCenter.y() + rsinTheta*sin(phi);
+    pointZ[i] = localCenter.z() + r*cosTheta;
+  }
+}
+
+
+// Reflect coordinate through limits until inside, allowing for surface
+// tolerance as with G4VSolid::Inside()
+
+namespace {
+  inline G4double FoldInto(G4double v, G4double lo, G4double hi,
+			   G4double tol) {
+    G4int ntries = 100;				// Avoid infinite loops
+    while (--ntries > 0) {
+      if (v > hi+tol) v = 2.*hi - v;
+      else if (v < lo-tol) v = 2.*lo - v;
+      else break;
+    }
+    return v;
+  }
+}
+
+// Fold all generated points into volume
+
+void G4CMPChargeCloud::FoldToShape() {
+  size_t npos = pointX.size();
+
+  if (shapeType == kBoxShape) {
+    for (size_t i=0; i<npos; i++) {
+      pointX[i] = FoldInto(pointX[i], -halfX, halfX, halfTolerance);
+      pointY[i] = FoldInto(pointY[i], -halfY, halfY, halfTolerance);
+      pointZ[i] = FoldInto(pointZ[i], -halfZ, halfZ, halfTolerance);
+    }
+  } else if (shapeType == kTubsShape) {
+    G4double rlo2 = (innerR>halfTolerance) ? sqr(innerR-halfTolerance) : -1.;
+    G4double rhi2 = sqr(outerR+halfTolerance);
+
+    for (size_t i=0; i<npos; i++) {
+      pointZ[i] = FoldInto(pointZ[i], -halfZ, halfZ, halfTolerance);
+
+      G4double r2 = pointX[i]*pointX[i] + pointY[i]*pointY[i];
+      if (r2 > rlo2 && r2 < rhi2) continue;	// Inside radially
+
+      G4double r = sqrt(r2);
+      G4double rnew = FoldInto(r, innerR, outerR, halfTolerance);
+      if (r > 0.) {
+	pointX[i] *= rnew/r;
+	pointY[i] *= rnew/r;
+      } else {
+	pointX[i] = rnew;			// Any direction from axis
+      }
+    }
+  } else if (shapeType == kGenericShape) {
+    G4ThreeVector point;
+    for (size_t i=0; i<npos; i++) {
+      point.set(pointX[i], pointY[i], pointZ[i]);
+      AdjustToVolume(point);
+      pointX[i] = point.x();
+      pointY[i] = point.y();
+      pointZ[i] = point.z();
+    }
+  }
+}
+
+
 // Adjust specified point to be inside volume
 
 void G4CMPChargeCloud::AdjustToVolume(G4ThreeVector& point) const {
@@ -37,11 +37,17 @@
 // 20210910  G4CMP-272:  Add parameter to set number of downsampled Luke phonons
 // 20220921  G4CMP-319:  Add temperature setting for use with QP sensors.
 // 20221014  G4CMP-334:  Add maxLukePhonons to printout; show macro commands
+// 20261018  Add flag to select uniformization for charge carrier steps
+// 20261018  Add flag and cache directory for KaplanQP response library
+// 20261018  Add flags to enable phonon scattering and decay separately
+// 20261018  Release tabulated NIEL yields when NIEL function is replaced
+// 20261018  Add energy window scale for uniformization majorant
 
 #include "G4CMPConfigManager.hh"
 #include "G4CMPConfigMessenger.hh"
 #include "G4CMPLewinSmithNIEL.hh"
 #include "G4CMPLindhardNIEL.hh"
+#include "G4CMPNIELTable.hh"
 #include "G4VNIELPartition.hh"
 #include "G4RunManager.hh"
 #include "G4SystemOfUnits.hh"
@@ -80,6 +86,7 @@ G4CMPConfigManager::G4CMPConfigManager()
     maxLukePhonons(getenv("G4MP_MAX_LUKE")?atoi(getenv("G4MP_MAX_LUKE")):-1),
     LatticeDir(getenv("G4LATTICEDATA")?getenv("G4LATTICEDATA"):"./CrystalMaps"),
     IVRateModel(getenv("G4CMP_IV_RATE_MODEL")?getenv("G4CMP_IV_RATE_MODEL"):"Quadratic"),
+    kaplanCache(getenv("G4CMP_KAPLAN_CACHE")?getenv("G4CMP_KAPLAN_CACHE"):""),
     eTrapMFP(getenv("G4CMP_ETRAPPING_MFP")?strtod(getenv("G4CMP_ETRAPPING_MFP"),0)*mm:DBL_MAX),
     hTrapMFP(getenv("G4CMP_HTRAPPING_MFP")?strtod(getenv("G4CMP_HTRAPPING_MFP"),0)*mm:DBL_MAX),
     eDTrapIonMFP(getenv("G4CMP_EDTRAPION_MFP")?strtod(getenv("G4CMP_EDTRAPION_MFP"),0)*mm:DBL_MAX),
@@ -94,9 +101,14 @@ G4CMPConfigManager::G4CMPConfigManager()
     genCharges(getenv("G4CMP_MAKE_CHARGES")?strtod(getenv("G4CMP_MAKE_CHARGES"),0):1.),
     lukeSample(getenv("G4CMP_LUKE_SAMPLE")?strtod(getenv("G4CMP_LUKE_SAMPLE"),0):1.),
     combineSteps(getenv("G4CMP_COMBINE_STEPLEN")?strtod(getenv("G4CMP_COMBINE_STEPLEN"),0):0.),
+    majorantScale(getenv("G4CMP_MAJORANT_SCALE")?strtod(getenv("G4CMP_MAJORANT_SCALE"),0):2.),
     EminPhonons(getenv("G4CMP_EMIN_PHONONS")?strtod(getenv("G4CMP_EMIN_PHONONS"),0)*eV:0.),
     EminCharges(getenv("G4CMP_EMIN_CHARGES")?strtod(getenv("G4CMP_EMIN_CHARGES"),0)*eV:0.),
     useKVsolver(getenv("G4CMP_USE_KVSOLVER")?atoi(getenv("G4CMP_USE_KVSOLVER")):0),
+    uniformize(getenv("G4CMP_UNIFORMIZATION")?atoi(getenv("G4CMP_UNIFORMIZATION")):0),
+    kaplanLibrary(getenv("G4CMP_KAPLAN_LIBRARY")?atoi(getenv("G4CMP_KAPLAN_LIBRARY")):0),
+    phononScatter(getenv("G4CMP_PHONON_SCATTERING")?atoi(getenv("G4CMP_PHONON_SCATTERING")):1),
+    phononDecay(getenv("G4CMP_PHONON_DECAY")?atoi(getenv("G4CMP_PHONON_DECAY")):1),
     fanoEnabled(getenv("G4CMP_FANO_ENABLED")?atoi(getenv("G4CMP_FANO_ENABLED")):1),
     chargeCloud(getenv("G4CMP_CHARGE_CLOUD")?atoi(getenv("G4CMP_CHARGE_CLOUD")):0),
     nielPartition(0), messenger(new G4CMPConfigMessenger(this)) {
@@ -121,7 +133,8 @@ G4CMPConfigManager::G4CMPConfigManager(const G4CMPConfigManager& master)
     ehBounces(master.ehBounces), pBounces(master.pBounces),
     maxLukePhonons(master.maxLukePhonons),
     version(master.version), LatticeDir(master.LatticeDir), 
-    IVRateModel(master.IVRateModel), eTrapMFP(master.eTrapMFP),
+    IVRateModel(master.IVRateModel), kaplanCache(master.kaplanCache),
+    eTrapMFP(master.eTrapMFP),
     hTrapMFP(master.hTrapMFP), eDTrapIonMFP(master.eDTrapIonMFP),
     eATrapIonMFP(master.eATrapIonMFP), hDTrapIonMFP(master.hDTrapIonMFP),
     hATrapIonMFP(master.hATrapIonMFP),
@@ -129,8 +142,12 @@ G4CMPConfigManager::G4CMPConfigManager(const G4CMPConfigManager& master)
     stepScale(master.stepScale), sampleEnergy(master.sampleEnergy), 
     genPhonons(master.genPhonons), genCharges(master.genCharges), 
     lukeSample(master.lukeSample), combineSteps(master.combineSteps),
+    majorantScale(master.majorantScale),
     EminPhonons(master.EminPhonons), EminCharges(master.EminCharges),
-    useKVsolver(master.useKVsolver), fanoEnabled(master.fanoEnabled),
+    useKVsolver(master.useKVsolver), uniformize(master.uniformize),
+    kaplanLibrary(master.kaplanLibrary),
+    phononScatter(master.phononScatter), phononDecay(master.phononDecay),
+    fanoEnabled(master.fanoEnabled),
     chargeCloud(master.chargeCloud), nielPartition(master.nielPartition),
     messenger(new G4CMPConfigMessenger(this)) {;}
 
@@ -162,6 +179,9 @@ void G4CMPConfigManager::setNIEL(G4String name) {
 }
 
 void G4CMPConfigManager::setNIEL(G4VNIELPartition* niel) {
+  if (niel == nielPartition) return;		// Nothing to change
+
+  G4CMPNIELTable::ReleaseTables(nielPartition);	// Address may be reused
   delete nielPartition;
   nielPartition = niel;
 }
@@ -195,6 +215,12 @@ void G4CMPConfigManager::printConfig(std::ostream& os) const {
      << "\n/g4cmp/minEPhonons " << EminPhonons/eV << " eV\t\t\t\t# G4CMP_EMIN_PHONONS"
      << "\n/g4cmp/minECharges " << EminCharges/eV << " eV\t\t\t\t# G4CMP_EMIN_CHARGES"
      << "\n/g4cmp/useKVsolver " << useKVsolver << "\t\t\t\t# G4CMP_USE_KVSOLVER"
+     << "\n/g4cmp/useUniformization " << uniformize << "\t\t\t# G4CMP_UNIFORMIZATION"
+     << "\n/g4cmp/majorantScale " << majorantScale << "\t\t\t\t# G4CMP_MAJORANT_SCALE"
+     << "\n/g4cmp/useKaplanLibrary " << kaplanLibrary << "\t\t\t# G4CMP_KAPLAN_LIBRARY"
+     << "\n/g4cmp/KaplanCacheDir " << kaplanCache << "\t\t\t# G4CMP_KAPLAN_CACHE"
+     << "\n/g4cmp/enablePhononScattering " << phononScatter << "\t\t# G4CMP_PHONON_SCATTERING"
+     << "\n/g4cmp/enablePhononDecay " << phononDecay << "\t\t\t# G4CMP_PHONON_DECAY"
      << "\n/g4cmp/enableFanoStatistics " << fanoEnabled << "\t\t\t# G4CMP_FANO_ENABLED"
      << "\n/g4cmp/createChargeCloud " << chargeCloud << "\t\t\t# G4CMP_CHARGE_CLOUD"
      << "\n/g4cmp/NIELPartition "
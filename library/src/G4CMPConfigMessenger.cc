@@ -38,6 +38,10 @@
 // 20210910  G4CMP-272:  Add parameter for soft maximum Luke phonons per event
 // 20220921  G4CMP-319:  Add temperature setting for use with QP sensors.
 // 20221214  G4CMP-350:  Bug fix for new temperature setting units.
+// 20261018  Add command to select uniformization for charge steps
+// 20261018  Add commands for KaplanQP response library and cache
+// 20261018  Add commands to enable phonon scattering and decay separately
+// 20261018  Add command for uniformization majorant energy window
 
 #include "G4CMPConfigMessenger.hh"
 #include "G4CMPConfigManager.hh"
@@ -60,8 +64,9 @@ G4CMPConfigMessenger::G4CMPConfigMessenger(G4CMPConfigManager* mgr)
     trapHMFPCmd(0), eDTrapIonMFPCmd(0), eATrapIonMFPCmd(0),
     hDTrapIonMFPCmd(0), hATrapIonMFPCmd(0), tempCmd(0), minstepCmd(0),
     makePhononCmd(0), makeChargeCmd(0), lukePhononCmd(0), dirCmd(0),
-    ivRateModelCmd(0), nielPartitionCmd(0), kvmapCmd(0), fanoStatsCmd(0),
-    ehCloudCmd(0) {
+    ivRateModelCmd(0), nielPartitionCmd(0), kaplanCacheCmd(0), kvmapCmd(0),
+    uniformCmd(0), majorantCmd(0), kaplanLibCmd(0), phonScatCmd(0), phonDecayCmd(0),
+    fanoStatsCmd(0), ehCloudCmd(0) {
   verboseCmd = CreateCommand<G4UIcmdWithAnInteger>("verbose",
 					   "Enable diagnostic messages");
 
@@ -130,6 +135,51 @@ G4CMPConfigMessenger::G4CMPConfigMessenger(G4CMPConfigManager* mgr)
   kvmapCmd->SetParameterName("lookup",true,false);
   kvmapCmd->SetDefaultValue(true);
 
+  uniformCmd = CreateCommand<G4UIcmdWithABool>("useUniformization",
+	   "Sample charge-carrier interactions from a majorant total rate");
+  uniformCmd->SetGuidance("Replaces energy-threshold step limits in the");
+  uniformCmd->SetGuidance("TimeStepper with a single exponential draw from");
+  uniformCmd->SetGuidance("a rate bounding Luke and intervalley scattering;");
+  uniformCmd->SetGuidance("null (self-scattering) steps are thinned out.");
+  uniformCmd->SetGuidance("Argument: true for uniformization, false for");
+  uniformCmd->SetGuidance("threshold-limited steps (G4CMP_UNIFORMIZATION).");
+  uniformCmd->SetParameterName("uniformize",true,false);
+  uniformCmd->SetDefaultValue(true);
+
+  majorantCmd = CreateCommand<G4UIcmdWithADouble>("majorantScale",
+	   "Energy window over which uniformization majorant is held");
+  majorantCmd->SetGuidance("Majorant rate is evaluated at this multiple of");
+  majorantCmd->SetGuidance("the carrier energy, and steps end (without an");
+  majorantCmd->SetGuidance("interaction) where field acceleration reaches it.");
+  majorantCmd->SetGuidance("Larger values take fewer steps but reject more.");
+
+  kaplanLibCmd = CreateCommand<G4UIcmdWithABool>("useKaplanLibrary",
+	   "Sample phonon absorption in films from precomputed responses");
+  kaplanLibCmd->SetGuidance("KaplanQP cascades are run once per energy bin");
+  kaplanLibCmd->SetGuidance("(or read from KaplanCacheDir), and each absorbed");
+  kaplanLibCmd->SetGuidance("phonon picks one stored cascade, scaled to its");
+  kaplanLibCmd->SetGuidance("energy.  Set false for exact cascade simulation.");
+  kaplanLibCmd->SetDefaultValue(true);
+
+  kaplanCacheCmd = CreateCommand<G4UIcmdWithAString>("KaplanCacheDir",
+	   "Directory to read and write KaplanQP response libraries");
+
+  phonScatCmd = CreateCommand<G4UIcmdWithABool>("enablePhononScattering",
+	   "Enable isotope scattering of phonons in the bulk");
+  phonScatCmd->SetGuidance("Set false to zero the scattering channel of the");
+  phonScatCmd->SetGuidance("phononScatteringAndDecay process, leaving decay");
+  phonScatCmd->SetGuidance("active (G4CMP_PHONON_SCATTERING).");
+  phonScatCmd->SetParameterName("scatter",true,false);
+  phonScatCmd->SetDefaultValue(true);
+
+  phonDecayCmd = CreateCommand<G4UIcmdWithABool>("enablePhononDecay",
+	   "Enable anharmonic decay of phonons in the bulk");
+  phonDecayCmd->SetGuidance("Set false to zero the downconversion channel of");
+  phonDecayCmd->SetGuidance("the phononScatteringAndDecay process, leaving");
+  phonDecayCmd->SetGuidance("scattering active (G4CMP_PHONON_DECAY).");
+  phonDecayCmd->SetParameterName("decay",true,false);
+  phonDecayCmd->SetDefaultValue(true);
+
   fanoStatsCmd = CreateCommand<G4UIcmdWithABool>("enableFanoStatistics",
            "Modify input ionization energy according to Fano statistics.");
   fanoStatsCmd->SetDefaultValue(true);
@@ -205,6 +255,12 @@ G4CMPConfigMessenger::~G4CMPConfigMessenger() {
   delete lukePhononCmd; lukePhononCmd=0;
   delete dirCmd; dirCmd=0;
   delete kvmapCmd; kvmapCmd=0;
+  delete uniformCmd; uniformCmd=0;
+  delete majorantCmd; majorantCmd=0;
+  delete kaplanLibCmd; kaplanLibCmd=0;
+  delete kaplanCacheCmd; kaplanCacheCmd=0;
+  delete phonScatCmd; phonScatCmd=0;
+  delete phonDecayCmd; phonDecayCmd=0;
   delete fanoStatsCmd; fanoStatsCmd=0;
   delete ehCloudCmd; ehCloudCmd=0;
   delete ivRateModelCmd; ivRateModelCmd=0;
@@ -265,6 +321,12 @@ void G4CMPConfigMessenger::SetNewValue(G4UIcommand* cmd, G4String value) {
     theManager->SetTemperature(tempCmd->GetNewDoubleValue(value));
 
   if (cmd == kvmapCmd) theManager->UseKVSolver(StoB(value));
+  if (cmd == uniformCmd) theManager->UseUniformization(StoB(value));
+  if (cmd == majorantCmd) theManager->SetMajorantScale(StoD(value));
+  if (cmd == kaplanLibCmd) theManager->UseKaplanLibrary(StoB(value));
+  if (cmd == kaplanCacheCmd) theManager->SetKaplanCacheDir(value);
+  if (cmd == phonScatCmd) theManager->EnablePhononScattering(StoB(value));
+  if (cmd == phonDecayCmd) theManager->EnablePhononDecay(StoB(value));
   if (cmd == fanoStatsCmd) theManager->EnableFanoStatistics(StoB(value));
   if (cmd == ivRateModelCmd) theManager->SetIVRateModel(value);
   if (cmd == nielPartitionCmd) theManager->SetNIELPartition(value);
@@ -10,22 +10,22 @@
 //
 // 20170815  Drop call to LoadDataForTrack(); now handled in process.
 // 20170820  Compute rate for L-type phonons; otherwise return 0.
+// 20261018  Compute rate from G4CMPRateContext, not from track
 
 #include "G4CMPDownconversionRate.hh"
 #include "G4LatticePhysical.hh"
 #include "G4PhononLong.hh"
 #include "G4PhysicalConstants.hh"
-#include "G4Track.hh"
 
 
 // Scattering rate is computed from electric field
 
-G4double G4CMPDownconversionRate::Rate(const G4Track& aTrack) const {
+G4double G4CMPDownconversionRate::Rate(const G4CMPRateContext& ctx) const {
   // If current particle type not L-phonon, do not decay
-  if (aTrack.GetDefinition() != G4PhononLong::Definition()) return 0.;
+  if (ctx.particle != G4PhononLong::Definition()) return 0.;
 
-  G4double A = theLattice->GetAnhDecConstant();
-  G4double Eoverh = GetKineticEnergy(aTrack)/h_Planck;
+  G4double A = ctx.lattice->GetAnhDecConstant();
+  G4double Eoverh = ctx.energy/h_Planck;
   
   return (Eoverh*Eoverh*Eoverh*Eoverh*Eoverh*A);
 }
@@ -16,6 +16,8 @@
 // 20171215  Replace boundary-point check with CheckStepBoundary()
 // 20180827  M. Kelsey -- Prevent partitioner from recomputing sampling factors
 // 20210328  Modify above; compute direct-phonon sampling factor here
+// 20261018  Get absorption thresholds from typed surface data
+// 20261018  Refresh surface data from BuildPhysicsTable()
 
 #include "G4CMPDriftBoundaryProcess.hh"
 #include "G4CMPConfigManager.hh"
@@ -24,6 +26,7 @@
 #include "G4CMPEnergyPartition.hh"
 #include "G4CMPGeometryUtils.hh"
 #include "G4CMPSecondaryUtils.hh"
+#include "G4CMPSurfaceLookup.hh"
 #include "G4CMPSurfaceProperty.hh"
 #include "G4CMPUtils.hh"
 #include "G4GeometryTolerance.hh"
@@ -52,6 +55,14 @@ G4CMPDriftBoundaryProcess::~G4CMPDriftBoundaryProcess() {
 }
 
 
+// Surface data is read by all worker threads; fill it once on master
+
+void G4CMPDriftBoundaryProcess::
+BuildPhysicsTable(const G4ParticleDefinition&) {
+  G4CMPSurfaceLookup::UpdateSurfaceData();
+}
+
+
 // Process actions
 
 G4double G4CMPDriftBoundaryProcess::
@@ -102,8 +113,8 @@ G4CMPDriftBoundaryProcess::PostStepDoIt(const G4Track& aTrack,
 
 G4bool G4CMPDriftBoundaryProcess::AbsorbTrack(const G4Track& aTrack,
                                               const G4Step& aStep) const {
-  G4double absMinK = (G4CMP::IsElectron(aTrack) ? GetMaterialProperty("minKElec")
-		      : G4CMP::IsHole(aTrack) ? GetMaterialProperty("minKHole")
+  G4double absMinK = (G4CMP::IsElectron(aTrack) ? surfData->minKElec
+		      : G4CMP::IsHole(aTrack) ? surfData->minKHole
 		      : -1.);
 
   if (absMinK < 0.) {
@@ -12,13 +12,12 @@
 // $Id$
 //
 // 20161111 Initial commit - R. Agnese
+// 20261018  Allocate from per-thread G4CMPTrackInfoPool
 
 #include "G4CMPDriftTrackInfo.hh"
 #include "G4LatticePhysical.hh"
 #include "G4ParticleDefinition.hh"
 
-//G4Allocator<G4CMPDriftTrackInfo> G4CMPDriftTrackInfoAllocator;
-
 G4CMPDriftTrackInfo::G4CMPDriftTrackInfo(const G4LatticePhysical* lat,
                                          G4int valIdx) :
                                          G4CMPVTrackInfo(lat) {
@@ -0,0 +1,123 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+// 20261018  New process to reduce per-step overhead of separate trap MFPs
+
+#include "G4CMPDriftTrapAndIonization.hh"
+#include "G4CMPDriftElectron.hh"
+#include "G4CMPDriftHole.hh"
+#include "G4CMPDriftTrapIonization.hh"
+#include "G4CMPDriftTrappingProcess.hh"
+#include "G4CMPSecondaryUtils.hh"
+#include "G4CMPUtils.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4RandomDirection.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+#include "Randomize.hh"
+#include <algorithm>
+
+
+// Constructor and destructor
+
+G4CMPDriftTrapAndIonization::
+G4CMPDriftTrapAndIonization(const G4String &name)
+  : G4CMPVDriftProcess(name, fChargeTrapAndIonization), totalRate(0.) {
+  std::fill(channelRate, channelRate+kNChannels, 0.);
+}
+
+G4CMPDriftTrapAndIonization::~G4CMPDriftTrapAndIonization() {;}
+
+
+// Fill channel rates once per track, rather than at every step
+
+void G4CMPDriftTrapAndIonization::LoadDataForTrack(const G4Track* aTrack) {
+  G4CMPVDriftProcess::LoadDataForTrack(aTrack);
+
+  const G4ParticleDefinition* pd = GetCurrentParticle();
+  G4ParticleDefinition* edrift = G4CMPDriftElectron::Definition();
+  G4ParticleDefinition* hdrift = G4CMPDriftHole::Definition();
+
+  G4double mfp[kNChannels];
+  mfp[kTrapping] = G4CMPDriftTrappingProcess::GetMeanFreePath(pd);
+  mfp[kDTrapIonization] = G4CMPDriftTrapIonization::GetMeanFreePath(pd, edrift);
+  mfp[kATrapIonization] = G4CMPDriftTrapIonization::GetMeanFreePath(pd, hdrift);
+
+  totalRate = 0.;
+  for (G4int i=0; i<kNChannels; i++) {
+    channelRate[i] = (mfp[i] > 0. && mfp[i] < DBL_MAX) ? 1./mfp[i] : 0.;
+    totalRate += channelRate[i];
+  }
+
+  if (verboseLevel > 1) {
+    G4cout << GetProcessName() << "::LoadDataForTrack: "
+	   << pd->GetParticleName() << " trapping " << mfp[kTrapping]/mm
+	   << " D-ionization " << mfp[kDTrapIonization]/mm
+	   << " A-ionization " << mfp[kATrapIonization]/mm << " mm" << G4endl;
+  }
+}
+
+
+// Single MFP from summed rate of all channels
+
+G4double G4CMPDriftTrapAndIonization::GetMeanFreePath(const G4Track&, G4double,
+						      G4ForceCondition*) {
+  return (totalRate > 0. ? 1./totalRate : DBL_MAX);
+}
+
+
+// Process actions
+
+G4VParticleChange*
+G4CMPDriftTrapAndIonization::PostStepDoIt(const G4Track& aTrack,
+					  const G4Step& /*aStep*/) {
+  ClearNumberOfInteractionLengthLeft();		// All processes should do this!
+
+  // Select channel by branching fraction
+  G4double select = G4UniformRand() * totalRate;
+  if (select < channelRate[kTrapping]) return DoTrapping(aTrack);
+
+  select -= channelRate[kTrapping];
+  if (select < channelRate[kDTrapIonization])
+    return DoTrapIonization(aTrack, G4CMPDriftElectron::Definition());
+
+  return DoTrapIonization(aTrack, G4CMPDriftHole::Definition());
+}
+
+G4VParticleChange*
+G4CMPDriftTrapAndIonization::DoTrapping(const G4Track& aTrack) {
+  aParticleChange.Initialize(aTrack);
+
+  if (verboseLevel > 1) {
+    G4cout << GetProcessName() << "::PostStepDoIt: "
+           << aTrack.GetDefinition()->GetParticleName()
+           << " trapped by an impurity.  No energy released."
+           << G4endl;
+  }
+
+  aParticleChange.ProposeTrackStatus(fStopAndKill);
+  return &aParticleChange;
+}
+
+G4VParticleChange*
+G4CMPDriftTrapAndIonization::DoTrapIonization(const G4Track& aTrack,
+					      G4ParticleDefinition* trapPD) {
+  aParticleChange.Initialize(aTrack);
+
+  if (verboseLevel > 1) {
+    G4cout << GetProcessName() << "::PostStepDoIt: "
+           << aTrack.GetDefinition()->GetParticleName()
+           << " impact ionization of a "
+	   << (G4CMP::IsElectron(trapPD) ? "e" : "h")
+	   << "-type impurity trap." << G4endl;
+  }
+
+  // Create secondary with minimal energy, assuming no momentum transfer
+  G4Track* knockon = G4CMP::CreateSecondary(aTrack, trapPD,
+					    G4RandomDirection(), 1e-3*eV);
+  aParticleChange.AddSecondary(knockon);
+
+  return &aParticleChange;
+}
@@ -59,6 +59,24 @@
 // 20220818  G4CMP-309 -- Don't skip GenerateCharges() or GeneratePhonons() if
 //		zero downsampling; want to get summary data filled every time.
 // 20221025  G4CMP-335 -- Skip and rethrow nPairs=0 returned from FanoBinomial.
+// 20261018  Store computed sampling in G4CMPSamplingContext, not config.
+// 20261018  Fill particle list once, in random order, from generated counts;
+//		avoids shuffling and reallocating the list for every deposit.
+// 20261018  Add QueuePrimaries() to deliver primaries in chunks through
+//		G4CMPStackingAction, rather than all at start of event.
+// 20261018  Reuse primary and secondary buffers between calls; don't shrink.
+// 20261018  Use G4CMPNIELTable for nuclear recoil yield when available.
+// 20261018  SetBiasVoltage() reuses per-thread touchable, and caches field
+//		value for uniform fields by volume and field object.
+// 20261018  QueuePrimaries() places charges at the same position as
+//		GetPrimaries(); drop unused charge-cloud bin position.
+// 20261018  Place charges at charge-cloud bin centers in both paths, with
+//		electron and hole of a pair in the same cloud entry; queue
+//		only per-vertex counts in G4CMPStackingAction.
+// 20261018  Reset sampling context only when computing downsampling, so
+//		preset factors from drift processes are kept.
+// 20261018  Cache uniform field value in its own frame, and rotate it with
+//		current touchable, so copies of a volume get their own field.
 
 #include "G4CMPEnergyPartition.hh"
 #include "G4CMPChargeCloud.hh"
@@ -68,14 +86,18 @@
 #include "G4CMPFanoBinomial.hh"
 #include "G4CMPFieldUtils.hh"
 #include "G4CMPGeometryUtils.hh"
+#include "G4CMPNIELTable.hh"
 #include "G4CMPPartitionData.hh"
 #include "G4CMPPartitionSummary.hh"
+#include "G4CMPSamplingContext.hh"
 #include "G4CMPSecondaryUtils.hh"
+#include "G4CMPStackingAction.hh"
 #include "G4CMPStepAccumulator.hh"
 #include "G4CMPUtils.hh"
 #include "G4VNIELPartition.hh"
 #include "G4DynamicParticle.hh"
 #include "G4Event.hh"
+#include "G4EventManager.hh"
 #include "G4HCofThisEvent.hh"
 #include "G4IonTable.hh"
 #include "G4LatticePhysical.hh"
@@ -92,34 +114,30 @@
 #include "G4RunManager.hh"
 #include "G4SDManager.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4UniformElectricField.hh"
 #include "G4VParticleChange.hh"
 #include "G4VPhysicalVolume.hh"
 #include "Randomize.hh"
 #include "CLHEP/Random/RandBinomial.h"
 #include <cmath>
+#include <map>
 #include <vector>
 
 
 // Constructors and destructor
 
-// TEMPORARY:  Flag to either compute Luke sampling, or use preset value
-namespace {
-  G4double lukeDownsampling = true;
-}
-
 G4CMPEnergyPartition::G4CMPEnergyPartition(G4Material* mat,
 					   G4LatticePhysical* lat)
   : G4CMPProcessUtils(), verboseLevel(G4CMPConfigManager::GetVerboseLevel()),
-    fillSummaryData(false), material(mat), biasVoltage(0.), 
+    fillSummaryData(false), material(mat), biasVoltage(0.), biasField(0),
+    biasFieldIsLocal(false),
     holeFraction(0.5), nParticlesMinimum(10),
     applyDownsampling(true), cloud(new G4CMPChargeCloud),
     nPairsTrue(0), nPairsGen(0), chargeEnergyLeft(0.),
     nPhononsTrue(0), nPhononsGen(0), phononEnergyLeft(0.),
+    pairEnergy(0.), pairWeight(0.), phononEnergy(0.), phononWeight(0.),
     summary(0) {
   SetLattice(lat);
-
-  // TEMPORARY: If user set Luke sampling negative, we compute it below
-  lukeDownsampling = (G4CMPConfigManager::GetLukeSampling() < 0.);
 }
 
 G4CMPEnergyPartition::G4CMPEnergyPartition(const G4VPhysicalVolume* volume)
@@ -156,9 +174,36 @@ void G4CMPEnergyPartition::UsePosition(const G4ThreeVector& pos) {
   SetBiasVoltage(pos);
 }
 
+
+// Uniform field has the same value throughout volume, so only thickness
+// through the position needs to be recomputed.  A field wrapped by
+// G4CMPLocalElectroMagField is defined in the volume's local frame, and
+// must be rotated for each placement (copy) of the volume.
+
 void G4CMPEnergyPartition::SetBiasVoltage(const G4ThreeVector& pos) {
-  G4VTouchable* touch = G4CMP::CreateTouchableAtPoint(pos);
-  biasVoltage = G4CMP::GetBiasThroughPosition(touch, pos);
+  const G4VTouchable* touch = G4CMP::LocateTouchableAtPoint(pos);
+  const G4LogicalVolume* lv = touch->GetVolume()->GetLogicalVolume();
+
+  const G4UniformElectricField* ufield = G4CMP::GetUniformField(lv);
+  if (!ufield) {
+    biasField = 0;
+    biasVoltage = G4CMP::GetBiasThroughPosition(touch, pos);
+  } else {
+    if (ufield != biasField) {
+      const G4double origin[4] = { 0., 0., 0., 0. };
+      G4double fieldVal[6];
+      ufield->GetFieldValue(origin, fieldVal);
+
+      biasField = ufield;
+      biasFieldValue.set(fieldVal[3], fieldVal[4], fieldVal[5]);
+      biasFieldIsLocal = (G4CMP::GetLocalField(lv) != 0);
+    }
+
+    G4ThreeVector field = biasFieldValue;
+    if (biasFieldIsLocal) G4CMP::RotateToGlobalDirection(touch, field);
+
+    biasVoltage = G4CMP::GetBiasThroughPosition(lv, field, pos);
+  }
 
   if (verboseLevel) {
     G4cout << "G4CMPEnergyPartition: est. " << biasVoltage/volt << " V"
@@ -201,7 +246,13 @@ LindhardScalingFactor(G4double E, G4double Z, G4double A) const {
   }
 
   const G4VNIELPartition* nielFunc = G4CMPConfigManager::GetNIELPartition();
-  return nielFunc->PartitionNIEL(E, material, Z, A);
+
+  // Interpolated table is shared by all partitioners for this material
+  const G4CMPNIELTable* nielTable =
+    G4CMPNIELTable::GetTable(nielFunc, material, Z, A);
+
+  return (nielTable ? nielTable->GetYield(E)
+	  : nielFunc->PartitionNIEL(E, material, Z, A));
 }
 
 
@@ -338,8 +389,9 @@ void G4CMPEnergyPartition::DoPartition(G4double eIon, G4double eNIEL) {
     return;
   }
 
-  particles.clear();		// Discard previous results
+  particles.clear();		// Discard previous results, keeping capacity
   nPairsTrue = nPhononsTrue = 0;
+  nPairsGen = nPhononsGen = 0;
 
   // Set up summary information block in event
   CreateSummary();
@@ -348,22 +400,23 @@ void G4CMPEnergyPartition::DoPartition(G4double eIon, G4double eNIEL) {
   summary->trueNIEL = eNIEL;
   summary->lindhardYield = eIon / (eIon+eNIEL);
 
-  // Apply downsampling if requested
-  if (applyDownsampling) ComputeDownsampling(eIon, eNIEL);
+  // Apply downsampling if requested, starting from user's settings;
+  // otherwise keep factors already computed (e.g., by drift processes)
+  G4CMPSamplingContext& sampling = G4CMPSamplingContext::Current();
+  if (applyDownsampling) {
+    sampling.Reset();
+    ComputeDownsampling(eIon, eNIEL);
+  }
 
   summary->samplingEnergy  = G4CMPConfigManager::GetSamplingEnergy();
-  summary->samplingCharges = G4CMPConfigManager::GetGenCharges();
-  summary->samplingPhonons = G4CMPConfigManager::GetGenPhonons();
-  summary->samplingLuke    = G4CMPConfigManager::GetLukeSampling();
+  summary->samplingCharges = sampling.GetGenCharges();
+  summary->samplingPhonons = sampling.GetGenPhonons();
+  summary->samplingLuke    = sampling.GetLukeSampling();
 
   chargeEnergyLeft = eIon;
   GenerateCharges(eIon);
   GeneratePhonons(eNIEL + chargeEnergyLeft);
-
-  particles.shrink_to_fit();	// Reduce size to match generated particles
-
-  // Shuffle particles so they can be distributed along trajectories
-  std::random_shuffle(particles.begin(), particles.end(), G4CMP::RandomIndex);
+  FillParticles();
 
   if (verboseLevel && summary) summary->Print();
 }
@@ -418,7 +471,7 @@ void G4CMPEnergyPartition::ComputeDownsampling(G4double eIon, G4double eNIEL) {
 	     << G4endl;
     }
 
-    G4CMPConfigManager::SetLukeSampling(lukeSamp);
+    G4CMPSamplingContext::Current().SetLukeSampling(lukeSamp);
   }
 }
 
@@ -429,7 +482,7 @@ void
 G4CMPEnergyPartition::ComputePhononSampling(G4double eNIEL) {
   G4double samplingScale = G4CMPConfigManager::GetSamplingEnergy();
   if (samplingScale <= 0.) return;		// No downsampling computation
-  if (G4CMPConfigManager::GetGenPhonons() <= 0.) return;
+  if (G4CMPSamplingContext::Current().GetGenPhonons() <= 0.) return;
   
   G4double phononScale = (samplingScale * theLattice->GetDebyeEnergy()
 			  / theLattice->GetPairProductionEnergy());
@@ -437,7 +490,7 @@ G4CMPEnergyPartition::ComputePhononSampling(G4double eNIEL) {
   if (verboseLevel>2)
     G4cout << " Downsample " << phononSamp << " primary phonons" << G4endl;
   
-  G4CMPConfigManager::SetGenPhonons(phononSamp);
+  G4CMPSamplingContext::Current().SetGenPhonons(phononSamp);
 }
 
 // Compute charge scaling factor only if not fully suppressed
@@ -446,13 +499,13 @@ void
 G4CMPEnergyPartition::ComputeChargeSampling(G4double eIon) {
   G4double samplingScale = G4CMPConfigManager::GetSamplingEnergy();
   if (samplingScale <= 0.) return;		// No downsampling computation
-  if (G4CMPConfigManager::GetGenCharges() <= 0.) return;
+  if (G4CMPSamplingContext::Current().GetGenCharges() <= 0.) return;
   
   G4double chargeSamp = (eIon>samplingScale)? samplingScale/eIon : 1.;
   if (verboseLevel>2)
     G4cout << " Downsample " << chargeSamp << " primary charges" << G4endl;
   
-  G4CMPConfigManager::SetGenCharges(chargeSamp);
+  G4CMPSamplingContext::Current().SetGenCharges(chargeSamp);
 }
 
 // Compute Luke scaling factor only if not fully suppressed
@@ -460,7 +513,7 @@ G4CMPEnergyPartition::ComputeChargeSampling(G4double eIon) {
 void G4CMPEnergyPartition::ComputeLukeSampling(G4double eIon) {
   G4double samplingScale = G4CMPConfigManager::GetSamplingEnergy();
   if (samplingScale <= 0.) return;		// No downsampling computation
-  if (!lukeDownsampling) return;		// User preset a fixed fraction
+  if (G4CMPConfigManager::GetLukeSampling() >= 0.) return;	// User preset
 
   // Expect about 500 Luke phonons, ~ 2 meV each, per e/h pair per volt
   // Note: number varies with material, this estmate is best for germanium
@@ -480,7 +533,7 @@ void G4CMPEnergyPartition::ComputeLukeSampling(G4double eIon) {
 	   << "\n Downsample " << lukeSamp << " Luke-phonon emission" << G4endl;
   }
 
-  G4CMPConfigManager::SetLukeSampling(lukeSamp);
+  G4CMPSamplingContext::Current().SetLukeSampling(lukeSamp);
 }
 
 
@@ -502,7 +555,7 @@ void G4CMPEnergyPartition::GenerateCharges(G4double energy) {
   }
 
   // Only apply downsampling to sufficiently large statistics
-  G4double scale = G4CMPConfigManager::GetGenCharges();
+  G4double scale = G4CMPSamplingContext::Current().GetGenCharges();
   if (scale>0. && (G4int)nPairsTrue <= nParticlesMinimum) scale = 1.;
 
   if (verboseLevel>1) {
@@ -516,16 +569,12 @@ void G4CMPEnergyPartition::GenerateCharges(G4double energy) {
 
   G4double nPairsWeighted = nPairsGen>0 ? nPairsGen/scale : 0.;
 
-  // Create requested number of charge pairs with scaling factor
-  if (nPairsGen > 0) {
-    particles.reserve(particles.size() + nPairsGen);
+  // Requested number of charge pairs, each with same energy and weight,
+  // will be created by FillParticles()
+  pairEnergy = ePair;
+  pairWeight = 1./scale;
 
-    // Generate number of requested charge pairs, each with same energy
-    for (size_t i=0; i<nPairsGen; i++) AddChargePair(ePair, 1./scale);
-    
-    if (verboseLevel>2)
-      G4cout << " generated " << nPairsGen << " e-h pairs" << G4endl;
-    
+  if (nPairsGen > 0) {
     chargeEnergyLeft = energy - ePair*nPairsWeighted;
     if (chargeEnergyLeft < 0.) chargeEnergyLeft = 0.;	// Avoid round-offs
   } else {
@@ -553,19 +602,15 @@ void G4CMPEnergyPartition::GenerateCharges(G4double energy) {
   }
 }
 
-void G4CMPEnergyPartition::AddChargePair(G4double ePair, G4double wt) {
-  G4double eFree = ePair - theLattice->GetBandGapEnergy(); // TODO: Is this right?
-
-  particles.push_back(Data(G4CMPDriftElectron::Definition(),G4RandomDirection(),
-			   (1.-holeFraction)*eFree, wt));
-
-  particles.push_back(Data(G4CMPDriftHole::Definition(), G4RandomDirection(),
-			   holeFraction*eFree, wt));
+void G4CMPEnergyPartition::AddCharge(G4ParticleDefinition* pd, G4double ekin,
+				     G4double wt) {
+  particles.push_back(Data(pd, G4RandomDirection(), ekin, wt));
 }
 
 void G4CMPEnergyPartition::GeneratePhonons(G4double energy) {
   if (energy <= 0.) {				// Avoid unnecessary work
     nPhononsTrue = nPhononsGen = 0;
+    phononEnergy = phononWeight = 0.;
     return;
   }
 
@@ -578,7 +623,7 @@ void G4CMPEnergyPartition::GeneratePhonons(G4double energy) {
   ePhon = energy / nPhononsTrue;		// Split energy evenly to all
 
   // Only apply downsampling to sufficiently large statistics
-  G4double scale = G4CMPConfigManager::GetGenPhonons();
+  G4double scale = G4CMPSamplingContext::Current().GetGenPhonons();
   if (scale>0. && (G4int)nPhononsTrue <= nParticlesMinimum) scale = 1.;
 
   if (verboseLevel>1) {
@@ -590,16 +635,10 @@ void G4CMPEnergyPartition::GeneratePhonons(G4double energy) {
   nPhononsGen = std::round(scale*nPhononsTrue);
   scale = nPhononsTrue>0 ? double(nPhononsGen)/nPhononsTrue : 1.;
 
-  // Create requested number of phonons with scaling factor
-  if (nPhononsGen > 0) {
-    particles.reserve(particles.size() + nPhononsGen);
-
-    // Generate number of requested charge pairs, each with same energy
-    for (size_t i=0; i<nPhononsGen; i++) AddPhonon(ePhon, 1./scale);
-    
-    if (verboseLevel>2)
-      G4cout << " generated " << nPhononsGen << " phonons" << G4endl;
-  }
+  // Requested number of phonons, each with same energy and weight, will
+  // be created by FillParticles()
+  phononEnergy = ePhon;
+  phononWeight = 1./scale;
 
   // Store generated information in summary block
   if (summary) {
@@ -619,6 +658,44 @@ void G4CMPEnergyPartition::AddPhonon(G4double ePhon, G4double wt) {
 }
 
 
+// Create generated charges and phonons in random order, so they can be
+// distributed along trajectories.  Choosing each entry's type in
+// proportion to those remaining is equivalent to shuffling the full list.
+
+void G4CMPEnergyPartition::FillParticles() {
+  particles.clear();
+  particles.reserve(GetNumberOfTracks());
+
+  G4ParticleDefinition* elec = G4CMPDriftElectron::Definition();
+  G4ParticleDefinition* hole = G4CMPDriftHole::Definition();
+
+  // TODO: Is this right?
+  G4double eFree = pairEnergy - theLattice->GetBandGapEnergy();
+  G4double eElec = (1.-holeFraction)*eFree;
+  G4double eHole = holeFraction*eFree;
+
+  size_t nElec = nPairsGen, nHole = nPairsGen, nPhon = nPhononsGen;
+  for (size_t nLeft=nElec+nHole+nPhon; nLeft>0; nLeft--) {
+    size_t pick = G4CMP::RandomIndex(nLeft);
+    if (pick < nElec) {
+      AddCharge(elec, eElec, pairWeight);
+      nElec--;
+    } else if (pick < nElec+nHole) {
+      AddCharge(hole, eHole, pairWeight);
+      nHole--;
+    } else {
+      AddPhonon(phononEnergy, phononWeight);
+      nPhon--;
+    }
+  }
+
+  if (verboseLevel>2) {
+    G4cout << " generated " << nPairsGen << " e-h pairs, " << nPhononsGen
+	   << " phonons" << G4endl;
+  }
+}
+
+
 // Return primary particles from partitioning as list
 
 void G4CMPEnergyPartition::
@@ -634,11 +711,7 @@ GetPrimaries(std::vector<G4PrimaryParticle*>& primaries) const {
   for (size_t i=0; i<particles.size(); i++) {
     const Data& p = particles[i];	// For convenience below
 
-    thePrim = new G4PrimaryParticle();
-    thePrim->SetParticleDefinition(p.pd);
-    thePrim->SetMomentumDirection(p.dir);
-    thePrim->SetKineticEnergy(p.ekin);
-    thePrim->SetWeight(p.wt);
+    thePrim = CreatePrimary(p);
     primaries.push_back(thePrim);
 
     if (verboseLevel==3) {
@@ -670,7 +743,7 @@ GetPrimaries(G4Event* event, const G4ThreeVector& pos, G4double time,
     summary->position[3] = time;
   }
 
-  std::vector<G4PrimaryParticle*> primaries;	// Can we make this mutable?
+  std::vector<G4PrimaryParticle*>& primaries = primBuffer;
   GetPrimaries(primaries);
 
   G4double chargeEtot = 0.;		// Cumulative buffers for diagnostics
@@ -695,15 +768,14 @@ GetPrimaries(G4Event* event, const G4ThreeVector& pos, G4double time,
   G4int ichg = 0;		// Counter to track charge cloud entries
   for (size_t i=0; i<primaries.size(); i++) {
     G4bool qcloud = doCloud && !G4CMP::IsPhonon(primaries[i]->GetG4code());
-    G4int chgbin = qcloud ? cloud->GetPositionBin(ichg++) : -1;
+    G4int chgbin = qcloud ? cloud->GetPositionBin(ichg++/2) : -1;
 
     G4PrimaryVertex*& vertex = activeVtx[chgbin];	// Ref for convenience
 
     // Create new vertex at pos if needed, or if current one is full
     if (!vertex ||
 	(maxPerVertex>0 && vertex->GetNumberOfParticle()>maxPerVertex)) {
-      G4ThreeVector binpos = chgbin>=0 ? cloud->GetBinCenter(chgbin) : newpos;
-      vertex = CreateVertex(event, newpos, time);
+      vertex = CreateVertex(event, GetBinPosition(touch, chgbin, newpos), time);
     }
 
     vertex->SetPrimary(primaries[i]);		// Add primary to vertex
@@ -755,7 +827,7 @@ GetPrimaries(G4Event* event, const std::vector<G4ThreeVector>& pos,
   size_t tracksPerPos = GetNumberOfTracks() / npos;
   size_t extraTracks = GetNumberOfTracks() - (tracksPerPos * npos);
 
-  std::vector<G4PrimaryParticle*> primaries;	// Can we make this mutable?
+  std::vector<G4PrimaryParticle*>& primaries = primBuffer;
   GetPrimaries(primaries);
 
   size_t iprim = 0;
@@ -777,6 +849,128 @@ GetPrimaries(G4Event* event, const std::vector<G4ThreeVector>& pos,
 }
 
 
+// Put first chunk of primaries into event, and queue the rest for
+// G4CMPStackingAction to push onto the stack as tracking proceeds
+
+void G4CMPEnergyPartition::
+QueuePrimaries(G4Event* event, const G4ThreeVector& pos, G4double time,
+	       G4int maxPerVertex) const {
+  G4CMPStackingAction* stacker = dynamic_cast<G4CMPStackingAction*>(
+    G4EventManager::GetEventManager()->GetUserStackingAction());
+
+  QueuePrimaries(stacker, event, pos, time, maxPerVertex);
+}
+
+void G4CMPEnergyPartition::
+QueuePrimaries(G4CMPStackingAction* stacker, G4Event* event,
+	       const G4ThreeVector& pos, G4double time,
+	       G4int maxPerVertex) const {
+  // Without G4CMP stacking, or for small deposits, fill event directly
+  if (!stacker || GetNumberOfTracks() <= stacker->GetChunkSize()) {
+    if (verboseLevel>1 && !stacker) {
+      G4cout << "G4CMPEnergyPartition::QueuePrimaries: no G4CMPStackingAction"
+	     << ", all primaries put into event" << G4endl;
+    }
+
+    GetPrimaries(event, pos, time, maxPerVertex);
+    return;
+  }
+
+  if (verboseLevel) {
+    G4cout << "G4CMPEnergyPartition::QueuePrimaries @ " << pos << " "
+	   << stacker->GetChunkSize() << " of " << GetNumberOfTracks()
+	   << " in event" << G4endl;
+  }
+
+  // Store position information in summary block
+  if (summary) {
+    summary->position[0] = pos[0];
+    summary->position[1] = pos[1];
+    summary->position[2] = pos[2];
+    summary->position[3] = time;
+  }
+
+  // Get volume touchable at point and enforce "IsInside()" position
+  G4VTouchable* touch = G4CMP::CreateTouchableAtPoint(pos);
+  G4ThreeVector newpos = G4CMP::ApplySurfaceClearance(touch, pos);
+
+  // Generate charge carriers in region around track position
+  G4bool doCloud = G4CMPConfigManager::CreateChargeCloud();	// Convenience
+  if (doCloud) {
+    cloud->SetVerboseLevel(verboseLevel);
+    cloud->SetTouchable(touch);
+    cloud->Generate(nPairsGen, newpos);
+  }
+
+  stacker->SetQueueEvent(event);
+
+  // Buffers for active vertices and queued counts, for use with charge cloud
+  std::map<G4int, G4PrimaryVertex*> activeVtx;
+  std::map<G4int, G4CMPStackingAction::QueuedVertex> queuedVtx;
+
+  G4double eFree = pairEnergy - theLattice->GetBandGapEnergy();
+
+  size_t nInEvent = stacker->GetChunkSize();
+  G4int ichg = 0;		// Counter to track charge cloud entries
+  for (size_t i=0; i<particles.size(); i++) {
+    const Data& p = particles[i];	// For convenience below
+
+    G4bool qcloud = doCloud && !G4CMP::IsPhonon(p.pd);
+    G4int chgbin = qcloud ? cloud->GetPositionBin(ichg++/2) : -1;
+
+    // Same placement as GetPrimaries(), so result doesn't depend on chunking
+    if (i >= nInEvent) {
+      auto qv = queuedVtx.find(chgbin);
+      if (qv == queuedVtx.end()) {
+	G4CMPStackingAction::QueuedVertex vtx(GetBinPosition(touch, chgbin,
+							     newpos),
+					      time, theLattice);
+	vtx.eElec = (1.-holeFraction)*eFree;
+	vtx.eHole = holeFraction*eFree;
+	vtx.ePhon = phononEnergy;
+	vtx.chargeWt = pairWeight;
+	vtx.phononWt = phononWeight;
+	qv = queuedVtx.insert(std::make_pair(chgbin, vtx)).first;
+      }
+
+      if (G4CMP::IsElectron(p.pd)) qv->second.nElec++;
+      else if (G4CMP::IsHole(p.pd)) qv->second.nHole++;
+      else qv->second.nPhon++;
+      continue;
+    }
+
+    G4PrimaryVertex*& vertex = activeVtx[chgbin];	// Ref for convenience
+
+    // Create new vertex at pos if needed, or if current one is full
+    if (!vertex ||
+	(maxPerVertex>0 && vertex->GetNumberOfParticle()>maxPerVertex)) {
+      vertex = CreateVertex(event, GetBinPosition(touch, chgbin, newpos), time);
+    }
+
+    vertex->SetPrimary(CreatePrimary(p));
+  }
+
+  for (const auto& qv: queuedVtx) stacker->QueueVertex(qv.second);
+
+  if (verboseLevel>1) {
+    G4cout << " " << event->GetNumberOfPrimaryVertex() << " vertices, "
+	   << stacker->GetNumberQueued() << " tracks queued at "
+	   << queuedVtx.size() << " positions" << G4endl;
+  }
+}
+
+
+// Charges are placed at center of their charge-cloud bin (global frame)
+
+G4ThreeVector 
+G4CMPEnergyPartition::GetBinPosition(const G4VTouchable* touch, G4int chgbin,
+				     const G4ThreeVector& pos) const {
+  if (chgbin < 0) return pos;
+
+  return G4CMP::GetGlobalPosition(touch, cloud->GetBinCenter(chgbin));
+}
+
+
 // Create primary vertex at specified location for filling
 
 G4PrimaryVertex* 
@@ -788,6 +982,18 @@ G4CMPEnergyPartition::CreateVertex(G4Event* evt, const G4ThreeVector& pos,
   return vertex;
 }
 
+// Create primary particle from generated entry
+
+G4PrimaryParticle* G4CMPEnergyPartition::CreatePrimary(const Data& p) const {
+  G4PrimaryParticle* thePrim = new G4PrimaryParticle();
+  thePrim->SetParticleDefinition(p.pd);
+  thePrim->SetMomentumDirection(p.dir);
+  thePrim->SetKineticEnergy(p.ekin);
+  thePrim->SetWeight(p.wt);
+
+  return thePrim;
+}
+
 
 // Return secondary particles from partitioning as list
 
@@ -852,8 +1058,6 @@ GetSecondaries(std::vector<G4Track*>& secondaries, G4double trkWeight) const {
       G4cout << "   Track Weight = " << theSec->GetWeight() << G4endl;
     }
   }
-
-  secondaries.shrink_to_fit();		// Reduce footprint if biasing done
 }
 
 // Return secondary particles from partitioning directly into event
@@ -865,7 +1069,7 @@ GetSecondaries(G4VParticleChange* aParticleChange) const {
 	   << G4endl;
   }
 
-  std::vector<G4Track*> secondaries;	// Can we make this a mutable buffer?
+  std::vector<G4Track*>& secondaries = secBuffer;
   GetSecondaries(secondaries, aParticleChange->GetWeight());
 
   aParticleChange->SetNumberOfSecondaries(secondaries.size());
@@ -20,6 +20,7 @@
 // 20190802  Check if field is aligned or anti-aligned with valley, apply
 //	     transform to valley axis "closest" to field direction.
 // 20210921  Add detailed debugging output, protected with G4CMP_DEBUG flag
+// 20261018  Add GetAcceleration() for analytic stepping in uniform fields
 
 #include "G4CMPEqEMField.hh"
 #include "G4CMPConfigManager.hh"
@@ -176,3 +177,27 @@ void G4CMPEqEMField::EvaluateRhsGivenB(const G4double y[],
   dydx[6] = 0.;			// not used
   dydx[7] = vinv;		// Lab Time of flight (sec/mm)
 }
+
+
+// Carrier acceleration for given field, without reference to track state
+
+G4ThreeVector G4CMPEqEMField::GetAcceleration(const G4double field[]) const {
+  G4ThreeVector accel(field[3], field[4], field[5]);
+  accel *= fCharge;
+
+  // No lattice behaviour, scalar mass
+  if (valleyIndex == -1) return accel/fMass;
+
+  // Valley mass tensor is applied in lattice frame, as for force above
+  fGlobalToLocal.ApplyAxisTransform(accel);
+  theLattice->RotateToLattice(accel);
+
+  const G4RotationMatrix& vToN = theLattice->GetValley(valleyIndex);
+  const G4RotationMatrix& nToV = theLattice->GetValleyInv(valleyIndex);
+  accel = nToV*(theLattice->GetMInvTensor()*(vToN*accel));
+
+  theLattice->RotateToSolid(accel);
+  fLocalToGlobal.ApplyAxisTransform(accel);
+
+  return accel;
+}
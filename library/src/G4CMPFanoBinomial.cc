@@ -14,16 +14,20 @@
 //		distribution vs. Geant4 internal subset.
 // 20210123  Strip all use of DoubConv (broken for us in CLHEP 2.4.4.1)
 // 20210412  Restrict Plo and Phi to be unit probability.
+// 20261018  Sample interpolated binomial from cached alias table, filled
+//		using log-gamma and recurrence; array methods do setup once.
 // =======================================================================
 
 #include "G4CMPFanoBinomial.hh"
 #include "CLHEP/Random/RandBinomial.h"
 #include "CLHEP/Random/RandGaussQ.h"
 #include "CLHEP/Random/RandPoissonQ.h"
+#include "CLHEP/Utility/thread_local.h"
 #include <algorithm>	// for min() and max()
 #include <cfloat>	// for DBL_MAX
-#include <cmath>	// for exp()
+#include <cmath>	// for exp(), lgamma()
 #include <iostream>
+#include <vector>
 
 using CLHEP::HepRandomEngine;
 
@@ -36,58 +40,252 @@ FanoBinomial::~FanoBinomial() {;}
 void FanoBinomial::shootArray( const int size, double* vect,
                             double mean, double fano )
 {
-  for( double* v = vect; v != vect+size; ++v )
-    *v = shoot(mean,fano);
+  genArray(HepRandom::getTheEngine(), size, vect, mean, fano);
 }
 
 void FanoBinomial::shootArray( HepRandomEngine* anEngine,
                             const int size, double* vect,
                             double mean, double fano )
 {
-  for( double* v = vect; v != vect+size; ++v )
-    *v = shoot(anEngine,mean,fano);
+  genArray(anEngine, size, vect, mean, fano);
 }
 
 void FanoBinomial::fireArray( const int size, double* vect,
                            double mean, double fano )
 {
-  for( double* v = vect; v != vect+size; ++v )
-    *v = fire(mean,fano);
+  genArray(localEngine.get(), size, vect, mean, fano);
 }
 
 
 
+// Sampling table for interpolated binomial distribution.  The most recent
+// table is kept, so repeated calls with the same arguments (e.g., from
+// shootArray()) skip the setup.  The first value is found by summing the
+// PDF; after that, an alias table (Walker's method) is built for O(1) use.
+
+struct FanoBinomial::InterpTable {
+  InterpTable() : mean(-1.), fano(-1.), sum(0.), nUsed(0) {;}
+
+  void fill(double theMean, double theFano);
+  long sample(HepRandomEngine* anEngine);
+
+  double mean, fano;		// Arguments used to fill table
+  std::vector<double> pdf;	// Interpolated PDF for 0 to nhi
+  double sum;			// Normalization of PDF
+  long nUsed;			// Number of values sampled
+
+  std::vector<double> accept;	// Probability to keep bin, else alias
+  std::vector<long> alias;
+
+private:
+  void addBinomial(long n, double p, double weight);
+  void fillAlias();
+};
+
+// Largest table to build; beyond this, use accept-reject loop
+const long FanoBinomial::maxTableSize = 100000L;
+
+
 // Implementation of "binomial interpolation" algorithm described in
 // the CDMS Experiment's "HVeV Run 1 Data Release" documentation
 // https://www.slac.stanford.edu/exp/cdms/ScienceResults/DataReleases/20190401_HVeV_Run1/HVeV_R1_Data_Release_20190401.pdf
 
 double FanoBinomial::genBinomial( HepRandomEngine *anEngine, double mean,
 				  double fano ) {
-  if (mean <= 0.) return 0.;		// Spread is ignored for zero binomial
-  if (mean <= 1.) return 1.;		// Single quantized result, no spread
+  double result = 0.;
+  genArray(anEngine, 1, &result, mean, fano);
+  return result;
+}
+
+// Choose method once for all values, since arguments are the same
+
+void FanoBinomial::genArray( HepRandomEngine *anEngine, const int size,
+			     double* vect, double mean, double fano ) {
+  if (size <= 0) return;
+
+  if (mean <= 0.) {			// Spread is ignored for zero binomial
+    std::fill(vect, vect+size, 0.);
+    return;
+  }
+
+  if (mean <= 1.) {			// Single quantized result, no spread
+    std::fill(vect, vect+size, 1.);
+    return;
+  }
 
   // Fano factor of 1. means Poisson distribution
-  if (fano == 1.) return CLHEP::RandPoissonQ::shoot(anEngine, mean);
+  if (fano == 1.) {
+    for (double* v = vect; v != vect+size; ++v)
+      *v = CLHEP::RandPoissonQ::shoot(anEngine, mean);
+    return;
+  }
 
   double prob = 1. - fano;
   double ntry = mean/prob;
 
   // Use Gaussian approximation where appropriate
-  if (mean > 9*(fano/prob) && mean > 9*(prob/fano))
-    return CLHEP::RandGaussQ::shoot(anEngine, mean, sqrt(mean*fano));
+  if (mean > 9*(fano/prob) && mean > 9*(prob/fano)) {
+    CLHEP::RandGaussQ::shootArray(anEngine, size, vect, mean,
+				  sqrt(mean*fano));
+    return;
+  }
 
   // If integer, then nlo==nhi and no interpolation is needed
   if (ntry == int(ntry)) {
-    return CLHEP::RandBinomial::shoot(anEngine, long(ntry), prob);
+    CLHEP::RandBinomial::shootArray(anEngine, size, vect, long(ntry), prob);
+    return;
   }
 
   // Implement interpolated binomial distribution
-  long nlo = std::floor(ntry);		
-  long nhi = std::ceil(ntry);
+  InterpTable* table = getInterpTable(mean, fano);
+  if (table) {
+    for (double* v = vect; v != vect+size; ++v) *v = table->sample(anEngine);
+  } else {
+    for (double* v = vect; v != vect+size; ++v)
+      *v = genInterpolated(anEngine, mean, fano);
+  }
+}
+
+// Bounding binomial distributions and interpolation weight
+
+void FanoBinomial::interpParams(double mean, double fano, long& nlo,
+				double& Plo, long& nhi, double& Phi,
+				double& dP) {
+  double prob = 1. - fano;
+  double ntry = mean/prob;
+
+  nlo = std::floor(ntry);
+  nhi = std::ceil(ntry);
+
+  Plo = std::min(mean/nlo, 1.);
+  Phi = std::min(mean/nhi, 1.);
+  dP = (prob - Plo)/(Phi - Plo);
+}
+
+// Fill (or reuse) table for interpolated distribution
+
+FanoBinomial::InterpTable*
+FanoBinomial::getInterpTable(double mean, double fano) {
+  static CLHEP_THREAD_LOCAL InterpTable* theTable = 0;
+  if (!theTable) theTable = new InterpTable;
+
+  if (theTable->mean != mean || theTable->fano != fano) {
+    if (std::ceil(mean/(1.-fano)) >= maxTableSize) return 0;
+    theTable->fill(mean, fano);
+  }
+
+  return theTable;
+}
+
+void FanoBinomial::InterpTable::fill(double theMean, double theFano) {
+  long nlo, nhi;
+  double Plo, Phi, dP;
+  interpParams(theMean, theFano, nlo, Plo, nhi, Phi, dP);
 
-  double Plo = std::min(mean/nlo, 1.);
-  double Phi = std::min(mean/nhi, 1.);
-  double dP = (prob - Plo)/(Phi - Plo);
+  pdf.assign(nhi+1L, 0.);
+  addBinomial(nlo, Plo, 1.-dP);
+  addBinomial(nhi, Phi, dP);
+
+  sum = 0.;
+  for (double p: pdf) sum += p;
+
+  mean = theMean;
+  fano = theFano;
+  nUsed = 0;
+  accept.clear();
+  alias.clear();
+}
+
+// Add weighted binomial PDF, starting from peak and using ratio of
+// successive terms; negligible tails are dropped
+
+void FanoBinomial::InterpTable::addBinomial(long n, double p, double weight) {
+  if (weight <= 0.) return;
+  if (p >= 1.) { pdf[n] += weight; return; }	// Delta function at n
+  if (p <= 0.) { pdf[0] += weight; return; }
+
+  long mode = std::min(long(std::floor((n+1)*p)), n);
+  double peak = weight * pdfBinomial(mode, n, p);
+  double cut = 1e-16 * peak;
+  double odds = p/(1.-p);
+
+  pdf[mode] += peak;
+
+  double term = peak;
+  for (long x=mode; x<n && term>cut; x++) {
+    term *= odds * double(n-x)/double(x+1);
+    pdf[x+1] += term;
+  }
+
+  term = peak;
+  for (long x=mode; x>0 && term>cut; x--) {
+    term *= double(x)/(odds * double(n-x+1));
+    pdf[x-1] += term;
+  }
+}
+
+// First use scans cumulative PDF; later uses build and use alias table
+
+long FanoBinomial::InterpTable::sample(HepRandomEngine* anEngine) {
+  long n = pdf.size();
+
+  if (nUsed++ == 0) {
+    double u = anEngine->flat() * sum;
+    for (long i=0; i<n; i++) {
+      u -= pdf[i];
+      if (u < 0.) return i;
+    }
+    return n-1;				// Round-off at end of range
+  }
+
+  if (accept.empty()) fillAlias();
+
+  double u = anEngine->flat() * n;
+  long i = std::min(long(u), n-1);
+  return (u-i < accept[i]) ? i : alias[i];
+}
+
+// Build alias table from PDF (Vose's method)
+
+void FanoBinomial::InterpTable::fillAlias() {
+  long n = pdf.size();
+  accept.resize(n);
+  alias.resize(n);
+
+  std::vector<long> small, large;
+  small.reserve(n);
+  large.reserve(n);
+
+  for (long i=0; i<n; i++) {
+    accept[i] = pdf[i] * n / sum;
+    alias[i] = i;
+    (accept[i] < 1. ? small : large).push_back(i);
+  }
+
+  while (!small.empty() && !large.empty()) {
+    long s = small.back(); small.pop_back();
+    long l = large.back();
+
+    alias[s] = l;
+    accept[l] -= 1. - accept[s];
+    if (accept[l] < 1.) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+
+  // Leftovers are unity, to within round-off
+  for (long i: small) accept[i] = 1.;
+  for (long i: large) accept[i] = 1.;
+}
+
+// Accept-reject loop, for distributions too wide to tabulate
+
+double FanoBinomial::genInterpolated( HepRandomEngine *anEngine, double mean,
+				      double fano ) {
+  long nlo, nhi;
+  double Plo, Phi, dP;
+  interpParams(mean, fano, nlo, Plo, nhi, Phi, dP);
 
   // Peak of PDF distribution is at the mean, either below or above
   double pdfMax = std::max(pdfBinomial(std::floor(mean), nlo, Plo),
@@ -111,27 +309,22 @@ double FanoBinomial::pdfBinomial(long x, long n, double p) {
   if (p <= 0. || p>1.) return 0.;
   if (p == 1.) return (x==n ? 1. : 0.);		// Delta function at n
 
-  double lnbin = log(p)*x + log(1.-p)*(n-x);	// p^x * (1-p)^(n-x)
+  // n!/(x!(n-x)!) * p^x * (1-p)^(n-x)
+  double lnbin = lnChoose(n,x) + log(p)*x + log(1.-p)*(n-x);
 
   // Upper and lower limits for exp(), not defined anywhere else?
   const double DBL_EXPARG_MAX=709.7, DBL_EXPARG_MIN=-708.3;
   if (lnbin < DBL_EXPARG_MIN) return 0.;
   if (lnbin > DBL_EXPARG_MAX) return DBL_MAX;
 
-  return Choose(n,x) * exp(lnbin);
+  return exp(lnbin);
 }
 
-double FanoBinomial::Choose(long n, long x) {
-  if (x>n/2) x = n-x;			// Symmetry reduces looping
-  if (x<0)  return 0.;			// Non-physical
-  if (x==0) return 1.;			// Simple cases avoid computation
-  if (x==1) return n;
+double FanoBinomial::lnChoose(long n, long x) {
+  if (x<0 || x>n) return -DBL_MAX;	// Non-physical
+  if (x==0 || x==n) return 0.;		// Simple cases avoid computation
 
-  double choose = 1.;
-  for (long k=1L; k<=x; k++) {
-    choose *= double(n-k+1L)/k;
-  }
-  return choose;
+  return (std::lgamma(n+1.) - std::lgamma(x+1.) - std::lgamma(n-x+1.));
 }
 
 
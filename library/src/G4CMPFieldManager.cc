@@ -21,6 +21,8 @@
 // 20200804  Attach local geometry shape to field
 // 20210901  Add local verbosity flag for reporting diagnostics, pass through
 //		to G4CMPLocalEMField.
+// 20261018  Use exact G4CMPUniformFieldStepper for uniform electric fields,
+//		rebuild transport if field is replaced.
 
 #include "G4CMPFieldManager.hh"
 #include "G4CMPConfigManager.hh"
@@ -30,6 +32,7 @@
 #include "G4CMPLocalElectroMagField.hh"
 #include "G4CMPDriftTrackInfo.hh"
 #include "G4CMPTrackUtils.hh"
+#include "G4CMPUniformFieldStepper.hh"
 #include "G4ChordFinder.hh"
 #include "G4ClassicalRK4.hh"
 #include "G4ElectroMagneticField.hh"
@@ -56,7 +59,8 @@ G4CMPFieldManager::G4CMPFieldManager(G4ElectroMagneticField *detectorField,
   : G4FieldManager(new G4CMPLocalElectroMagField(detectorField)),
     verboseLevel(vb==0?G4CMPConfigManager::GetVerboseLevel():vb),
     myDetectorField(0), stepperVars(8), stepperLength(1e-9*mm),
-    latticeNulls(0), maxLatticeNulls(3) {
+    latticeNulls(0), maxLatticeNulls(3), theEqMotion(0), theStepper(0),
+    theDriver(0), theChordFinder(0) {
   if (verboseLevel)
     G4cout << "G4CMPFieldManager wrapped global field in LocalEMField." << G4endl;
 
@@ -73,7 +77,8 @@ G4CMPFieldManager::G4CMPFieldManager(G4CMPLocalElectroMagField *detectorField,
   : G4FieldManager(detectorField),
     verboseLevel(vb==0?G4CMPConfigManager::GetVerboseLevel():vb),
     myDetectorField(detectorField), stepperVars(8), stepperLength(1e-9*mm),
-    latticeNulls(0), maxLatticeNulls(3) {
+    latticeNulls(0), maxLatticeNulls(3), theEqMotion(0), theStepper(0),
+    theDriver(0), theChordFinder(0) {
   if (verboseLevel)
     G4cout << "G4CMPFieldManager provided with wrapped LocalEMField." << G4endl;
 
@@ -82,17 +87,27 @@ G4CMPFieldManager::G4CMPFieldManager(G4CMPLocalElectroMagField *detectorField,
 }
 
 G4CMPFieldManager::~G4CMPFieldManager() {
-  delete theEqMotion;       theEqMotion=0;
-  delete theStepper;        theStepper=0;
-  delete theChordFinder;    theChordFinder=0;
+  DeleteTransport();
 }
 
 
 // Create all of the pieces for transport through electric field
+// Uniform fields have an exact solution, avoiding RK4 integration
 
 void G4CMPFieldManager::CreateTransport() {
-  theEqMotion    = new G4CMPEqEMField(myDetectorField);
-  theStepper     = new G4ClassicalRK4(theEqMotion, stepperVars);
+  DeleteTransport();
+
+  theEqMotion = new G4CMPEqEMField(myDetectorField);
+
+  if (myDetectorField && myDetectorField->IsUniformField()) {
+    if (verboseLevel)
+      G4cout << "G4CMPFieldManager using exact uniform-field stepper" << G4endl;
+
+    theStepper = new G4CMPUniformFieldStepper(theEqMotion, stepperVars);
+  } else {
+    theStepper = new G4ClassicalRK4(theEqMotion, stepperVars);
+  }
+
   theDriver      = new G4MagInt_Driver(stepperLength, theStepper, stepperVars);
   theChordFinder = new G4ChordFinder(theDriver);
   SetChordFinder(theChordFinder);
@@ -102,6 +117,13 @@ void G4CMPFieldManager::CreateTransport() {
   theChordFinder->SetVerbose(verboseLevel);
 }
 
+void G4CMPFieldManager::DeleteTransport() {
+  delete theEqMotion;       theEqMotion=0;
+  delete theStepper;        theStepper=0;
+  delete theChordFinder;    theChordFinder=0;	// Also deletes theDriver
+  theDriver=0;
+}
+
 
 // Run-time Configuration
 
@@ -136,6 +158,7 @@ void G4CMPFieldManager::ConfigureForTrack(const G4Track* aTrack) {
     myDetectorField->SetVerboseLevel(verboseLevel);
 
     ChangeDetectorField(myDetectorField);
+    CreateTransport();			// Equation of motion uses new field
   }
 
   // Configure equation of motion with physical lattice
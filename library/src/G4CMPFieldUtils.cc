@@ -9,6 +9,7 @@
 // Description: Free standing helper functions for electric field access
 //
 // 20180622  Michael Kelsey
+// 20261018  Add GetBiasThroughPosition() for already known field vector
 
 #include "G4CMPFieldUtils.hh"
 #include "G4CMPGeometryUtils.hh"
@@ -121,6 +122,15 @@ G4double G4CMP::GetBiasThroughPosition(const G4VTouchable* touch,
 
   const G4LogicalVolume* vol = (touch ? touch->GetVolume()->GetLogicalVolume()
 				: GetVolumeAtPoint(pos)->GetLogicalVolume());
+
+  return GetBiasThroughPosition(vol, field, pos);
+}
+
+G4double G4CMP::GetBiasThroughPosition(const G4LogicalVolume* vol,
+				       const G4ThreeVector& field,
+				       const G4ThreeVector& pos) {
+  if (field.isNear(origin)) return 0.;		// No field, no bias estimate
+
   G4VSolid* shape = vol->GetSolid();
 
   // Thickness of volume through point along local field direction
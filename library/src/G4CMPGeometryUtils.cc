@@ -14,6 +14,8 @@
 // 20170913  Add utility to get electric field at (global) position
 // 20170925  Add utility to create touchable at (global) position
 // 20190226  Use local instance of G4Navigator to avoid corrupting tracking
+// 20261018  Add reusable per-thread touchable for repeated point lookups
+// 20261018  Delete per-thread touchable at thread end
 
 #include "G4CMPGeometryUtils.hh"
 #include "G4CMPConfigManager.hh"
@@ -137,6 +139,43 @@ G4VTouchable* G4CMP::CreateTouchableAtPoint(const G4ThreeVector& pos) {
 }
 
 
+// Reuse touchable ("cursor") from previous lookup on this thread.  A leaf
+// volume (no daughters) containing the point must be the volume at that
+// point, so navigation is needed only when the point leaves it.
+
+namespace {
+  // Owns the thread's cursor, so that it is deleted when the thread ends
+  struct TouchableCursor {
+    TouchableCursor() : touch(0), world(0) {;}
+    ~TouchableCursor() { delete touch; }
+
+    G4TouchableHistory* touch;
+    G4VPhysicalVolume* world;		// Cursor is invalid if world changes
+  };
+}
+
+const G4VTouchable* G4CMP::LocateTouchableAtPoint(const G4ThreeVector& pos) {
+  G4ThreadLocalStatic TouchableCursor theCursor;
+  G4TouchableHistory*& cursor = theCursor.touch;
+
+  G4Navigator* nav = GetNavigator();
+  if (!cursor || theCursor.world != nav->GetWorldVolume()) {
+    delete cursor;
+    cursor = new G4TouchableHistory;
+    theCursor.world = nav->GetWorldVolume();
+  } else if (cursor->GetVolume()) {
+    const G4LogicalVolume* lv = cursor->GetVolume()->GetLogicalVolume();
+    if (lv->GetNoDaughters() == 0 &&
+	lv->GetSolid()->Inside(GetLocalPosition(cursor, pos)) == kInside) {
+      return cursor;
+    }
+  }
+
+  nav->LocateGlobalPointAndUpdateTouchable(pos, cursor, false);
+  return cursor;
+}
+
+
 // Adjust specified position to avoid surface of current (touchable) volume
 
 G4ThreeVector G4CMP::ApplySurfaceClearance(const G4VTouchable* touch,
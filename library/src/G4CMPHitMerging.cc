@@ -14,6 +14,7 @@
 // 20220815  Michael Kelsey -- Extracted from G4CMPSecondaryProduction
 // 20220821  G4CMP-308 -- Use new G4CMPStepInfo container instead of G4Step
 // 20220828  Pass event ID through to accumulator; improve debugging output
+// 20261018  Replace accumulator map with dense slots and open-addressed index
 
 #include "G4CMPHitMerging.hh"
 #include "G4CMPConfigManager.hh"
@@ -45,13 +46,12 @@
 G4CMPHitMerging::G4CMPHitMerging()
   : G4CMPProcessUtils(), verboseLevel(G4CMPConfigManager::GetVerboseLevel()),
     combiningStepLength(G4CMPConfigManager::GetComboStepLength()),
-    accumulator(0), currentEventID(-1),
+    nSlotsUsed(0), slotIndex(64, -1), accumulator(0), currentEventID(-1),
     partitioner(new G4CMPEnergyPartition) {
   partitioner->FillSummary(true);	// Collect partition summary data
 }
 
 G4CMPHitMerging::~G4CMPHitMerging() {
-  trackAccum.clear();
   delete partitioner;
 }
 
@@ -100,7 +100,7 @@ void G4CMPHitMerging::ProcessEvent(const G4Event* currentEvent) {
   G4int thisEvent = currentEvent->GetEventID();
   if (thisEvent != currentEventID) {
     if (verboseLevel>1) G4cout << " New event: clearing accumulators" << G4endl;
-    trackAccum.clear();
+    ClearAccumulators();
     currentEventID = thisEvent;
   }
 
@@ -137,7 +137,7 @@ G4bool G4CMPHitMerging::ProcessStep(const G4CMPStepInfo& stepData) {
   if (verboseLevel) G4cout << "G4CMPHitMerging::ProcessStep" << G4endl;
 
   // Direct step accumulator to work with current track and event
-  accumulator = &trackAccum[stepData.trackID];	// Creates new if needed
+  accumulator = GetAccumulator(stepData.trackID);	// Creates new if needed
   accumulator->ProcessEvent(currentEventID);
 
   // Set up energy partitioning to work with current track and volume
@@ -324,7 +324,7 @@ void G4CMPHitMerging::FillOutput(G4Event* primaryEvent, G4double time) {
 // Check for any non-empty accumulators, and generate primaries from them
 
 void G4CMPHitMerging::FinishOutput(G4Event* primaryEvent) {
-  if (trackAccum.empty()) return;		// Nothing to be done
+  if (nSlotsUsed == 0) return;			// Nothing to be done
   if (!primaryEvent) return;
 
   if (primaryEvent->GetEventID() != currentEventID) {
@@ -343,15 +343,15 @@ void G4CMPHitMerging::FinishOutput(G4Event* primaryEvent) {
   }
 
   // Loop over all registered accumulators and flush them to output
-  for (const auto& trkAcc: trackAccum) {
-    FlushAccumulator(trkAcc.first, primaryEvent);
+  for (size_t i=0; i<nSlotsUsed; i++) {
+    FlushAccumulator(slotTrackID[i], primaryEvent);
   }
 }
 
 // Process specified accumulator into new primaries for event
 
 void G4CMPHitMerging::FlushAccumulator(G4int trkID, G4Event* primaryEvent) {
-  accumulator = &trackAccum[trkID];
+  accumulator = GetAccumulator(trkID);
   if (accumulator->nsteps == 0) return;		// Nothing to be done
   
   if (verboseLevel>1) {
@@ -366,6 +366,52 @@ void G4CMPHitMerging::FlushAccumulator(G4int trkID, G4Event* primaryEvent) {
   accumulator->Clear();
 }
 
+// Track IDs within an event are mostly sequential, so the low bits are
+// used directly as the index hash, with linear probing
+
+G4CMPStepAccumulator* G4CMPHitMerging::GetAccumulator(G4int trkID) {
+  size_t mask = slotIndex.size()-1;		// Size is always power of two
+  size_t h = size_t(trkID) & mask;
+
+  for (; slotIndex[h] >= 0; h = (h+1) & mask) {
+    if (slotTrackID[slotIndex[h]] == trkID) return &accumSlots[slotIndex[h]];
+  }
+
+  // New track: keep index at most half full
+  if (2*(nSlotsUsed+1) > slotIndex.size()) {
+    ResizeSlotIndex(2*slotIndex.size());
+    return GetAccumulator(trkID);
+  }
+
+  if (nSlotsUsed == accumSlots.size()) {
+    accumSlots.push_back(G4CMPStepAccumulator());
+    slotTrackID.push_back(trkID);
+  } else {
+    accumSlots[nSlotsUsed].Clear();
+    slotTrackID[nSlotsUsed] = trkID;
+  }
+
+  slotIndex[h] = nSlotsUsed;
+  return &accumSlots[nSlotsUsed++];
+}
+
+void G4CMPHitMerging::ClearAccumulators() {
+  nSlotsUsed = 0;
+  std::fill(slotIndex.begin(), slotIndex.end(), -1);
+}
+
+void G4CMPHitMerging::ResizeSlotIndex(size_t size) {
+  slotIndex.assign(size, -1);
+
+  size_t mask = size-1;
+  for (size_t i=0; i<nSlotsUsed; i++) {
+    size_t h = size_t(slotTrackID[i]) & mask;
+    while (slotIndex[h] >= 0) h = (h+1) & mask;
+    slotIndex[h] = i;
+  }
+}
+
+
 // Generate intermediate points along step trajectory (straight line!)
 // NOTE:  For MSC type deposition, these points ought to be a random walk
 
@@ -12,52 +12,32 @@
 // 20170830  Follow Jacoboni, with unified D0/D1 expression and units; drop
 //		acoustic rate, as it is _intra_valley.
 // 20170919  Add interface for threshold identification
+// 20261018  Compute rate from G4CMPRateContext; lattice parameters are
+//		taken from context instead of reloading track data.
+// 20261018  Use sorted thresholds and constants precomputed per lattice
 
 #include "G4CMPInterValleyRate.hh"
 #include "G4LatticePhysical.hh"
-#include "G4LogicalVolume.hh"
 #include "G4PhysicalConstants.hh"
 #include "G4RotationMatrix.hh"
 #include "G4SystemOfUnits.hh"
-#include "G4Track.hh"
-#include "G4VPhysicalVolume.hh"
+#include <algorithm>
 #include <math.h>
 
 
-// Initialize lattice parameters used in matrix element calculations
-
-void G4CMPInterValleyRate::LoadDataForTrack(const G4Track* track) {
-  G4CMPProcessUtils::LoadDataForTrack(track);
-
-  // Should temperature be a lattice configuration?
-  kT = k_Boltzmann * 0.015*kelvin;
-
-  uSound = (2.*theLattice->GetTransverseSoundSpeed()
-	    + theLattice->GetSoundSpeed()) / 3.;
-
-  density = theLattice->GetDensity();
-  alpha = theLattice->GetAlpha();
-  nValley = 2*theLattice->NumberOfValleys()-1;		// From symmetry
-
-  m_DOS = theLattice->GetElectronDOSMass();
-  m_DOS3half = sqrt(m_DOS*m_DOS*m_DOS);
-}
-
-
 // Scattering rate is computed from matrix elements
 
-G4double G4CMPInterValleyRate::Rate(const G4Track& aTrack) const {
-  const_cast<G4CMPInterValleyRate*>(this)->LoadDataForTrack(&aTrack);
-
-  // Initialize numerical buffers
-  eTrk = GetKineticEnergy(aTrack);
+G4double G4CMPInterValleyRate::Rate(const G4CMPRateContext& ctx) const {
+  G4double eTrk = ctx.energy;
   if (verboseLevel>1)
     G4cout << "G4CMPInterValleyRate eTrk " << eTrk/eV << " eV" << G4endl;
 
-  G4double orate = opticalRate();
+  const G4CMPIVRateData& iv = ctx.lattice->GetIVRateData();
+
+  G4double orate = opticalRate(iv, eTrk);
   if (verboseLevel>2) G4cout << "IV phonons  " << orate/hertz << " Hz" << G4endl;
  
-  G4double nrate = scatterRate();
+  G4double nrate = scatterRate(iv, eTrk);
   if (verboseLevel>2) G4cout << "IV neutrals " << nrate/hertz << " Hz" << G4endl;
 
   G4double rate = nrate + orate;
@@ -68,33 +48,39 @@ G4double G4CMPInterValleyRate::Rate(const G4Track& aTrack) const {
 
 // Compute components of overall intervalley rate
 
-G4double G4CMPInterValleyRate::acousticRate() const {
-  G4double D_ac  = theLattice->GetAcousticDeform();
+G4double G4CMPInterValleyRate::acousticRate(const G4LatticePhysical* lat,
+					    G4double eTrk) const {
+  // Should temperature be a lattice configuration?
+  G4double kT = k_Boltzmann * 0.015*kelvin;
+
+  G4double uSound = (2.*lat->GetTransverseSoundSpeed()
+		     + lat->GetSoundSpeed()) / 3.;
+
+  G4double m_DOS = lat->GetElectronDOSMass();
+  G4double m_DOS3half = sqrt(m_DOS*m_DOS*m_DOS);
+
+  G4double D_ac  = lat->GetAcousticDeform();
   G4double D_ac_sq = D_ac*D_ac;
 
-  return ( sqrt(2)*kT * m_DOS3half * D_ac_sq * energyFunc(eTrk)
-	   / (pi*hbar_4th*density*uSound*uSound) );
+  return ( sqrt(2)*kT * m_DOS3half * D_ac_sq * energyFunc(eTrk,lat->GetAlpha())
+	   / (pi*hbar_4th*lat->GetDensity()*uSound*uSound) );
 }
 
-G4double G4CMPInterValleyRate::opticalRate() const {
-   // FIXME:  Rate should not have 'kT', but leaving it out ruins drift curve
-  G4double scale = nValley*/*kT**/m_DOS3half / (sqrt(2)*pi*hbar_sq*density);
-
+G4double G4CMPInterValleyRate::opticalRate(const G4CMPIVRateData& iv,
+					   G4double eTrk) const {
   G4double total = 0.;
-  G4int N_op = theLattice->GetNIVDeform();
-  for (G4int i = 0; i<N_op; i++) {
-    G4double Emin_op = theLattice->GetIVEnergy(i);
-    if (eTrk <= Emin_op) continue;		// Apply threshold behaviour
-
-    G4double D_op = theLattice->GetIVDeform(i);
-    G4double oscale = scale * D_op*D_op / Emin_op;
+  size_t N_op = iv.threshold.size();
+  for (size_t i = 0; i<N_op; i++) {
+    G4double Emin_op = iv.threshold[i];
+    if (eTrk <= Emin_op) break;		// Thresholds are sorted ascending
 
-    G4double Efunc = energyFunc(eTrk-Emin_op);	// Energy above threshold
+    G4double Efunc = energyFunc(eTrk-Emin_op, iv.alpha);   // Energy above thresh.
 
-    G4double orate = oscale * Efunc;
+    G4double orate = iv.opticalScale[i] * Efunc;
 
     if (verboseLevel>2) {
-      G4cout << " oscale[" << i << "] " << oscale << " Efunc " << Efunc
+      G4cout << " oscale[" << i << "] " << iv.opticalScale[i]
+	     << " Efunc " << Efunc
 	     << "\n phonon rate [" << i << "] " << orate/hertz << " Hz"
 	     << G4endl;
     }
@@ -105,25 +91,20 @@ G4double G4CMPInterValleyRate::opticalRate() const {
   return total;
 }
 
-G4double G4CMPInterValleyRate::scatterRate() const {
-  G4double n_I = theLattice->GetImpurities();		// Number density
-  G4double epsilon_r = theLattice->GetPermittivity();	// Dielectric constant
-  G4double E_T = 0.75*eV * (m_DOS/m_electron) / epsilon_r;
-  
-  return ( 4*sqrt(2)* n_I * hbar_sq * sqrt(eTrk)
-	   / (m_DOS3half * (eTrk+E_T)) );
+G4double G4CMPInterValleyRate::scatterRate(const G4CMPIVRateData& iv,
+					   G4double eTrk) const {
+  return iv.impurityScale * sqrt(eTrk) / (eTrk+iv.impurityEnergy);
 }
 
 
 // Identify next energy threshold (if any) above specified input
 
 G4double G4CMPInterValleyRate::Threshold(G4double Eabove) const {
-  // Get list of all energy thresholds and sort
-  std::vector<G4double> E_op = theLattice->GetIVEnergy();
+  // Energy thresholds are sorted once per lattice
+  const std::vector<G4double>& E_op = theLattice->GetIVRateData().threshold;
   if (E_op.empty()) return 0.;
 
-  // Put energies in order, find nearest entry above input value
-  std::sort(E_op.begin(), E_op.end());
+  // Find nearest entry above input value
   std::vector<G4double>::const_iterator thresh =
     std::upper_bound(E_op.begin(), E_op.end(), Eabove);
 
@@ -25,6 +25,7 @@
 // 20190704  Add selection of rate model by name, and material specific
 // 20190904  C. Stanford -- Add 50% momentum flip (see G4CMP-168)
 // 20190906  Push selected rate model back to G4CMPTimeStepper for consistency
+// 20261018  Suppress own MFP when G4CMPTimeStepper uses uniformization.
 
 #include "G4CMPInterValleyScattering.hh"
 #include "G4CMPConfigManager.hh"
@@ -95,6 +96,13 @@ G4double G4CMPInterValleyScattering::GetMeanFreePath(const G4Track& track,
 						     G4double prevStep,
 						     G4ForceCondition* cond) {
   UseRateModel(theLattice->GetIVModel());	// Use current material's rate
+
+  // With uniformization, scattering is triggered by G4CMPTimeStepper
+  if (G4CMPConfigManager::UseUniformization()) {
+    *cond = NotForced;
+    return DBL_MAX;
+  }
+
   return G4CMPVProcess::GetMeanFreePath(track, prevStep, cond);
 }
 
@@ -0,0 +1,70 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/src/G4CMPInverseCDFTable.cc
+/// \brief Tabulated inverse cumulative distributions for sampling a
+///	   one-parameter family of densities p(u; s) on u in [0,1].
+//
+// 20261018  New class for rejection-free sampling of tabulated densities
+
+#include "G4CMPInverseCDFTable.hh"
+#include <algorithm>
+
+
+// Invert piecewise-linear CDF at equally spaced quantiles
+
+void G4CMPInverseCDFTable::
+FillQuantiles(G4int ipar, const std::vector<G4double>& cellWeight) {
+  G4double* row = &quantile[ipar*(nQuant+1)];
+  G4int nfine = cellWeight.size();
+
+  G4double total = 0.;
+  for (G4int i=0; i<nfine; i++) total += cellWeight[i];
+
+  // Degenerate density:  fall back to uniform distribution
+  if (total <= 0.) {
+    for (G4int j=0; j<=nQuant; j++) row[j] = G4double(j)/nQuant;
+    return;
+  }
+
+  G4double cdf = 0.;		// CDF at lower edge of cell i
+  G4int i = 0;
+  for (G4int j=0; j<=nQuant; j++) {
+    G4double target = total*j/nQuant;
+    while (i < nfine-1 && cdf+cellWeight[i] < target) cdf += cellWeight[i++];
+
+    G4double frac = (cellWeight[i] > 0.) ? (target-cdf)/cellWeight[i] : 0.;
+    row[j] = (i + std::min(std::max(frac, 0.), 1.)) / nfine;
+  }
+
+  row[0] = 0.;			// Ensure exact endpoints
+  row[nQuant] = 1.;
+}
+
+
+// Sample from table, interpolating between quantiles and parameter rows
+
+G4double G4CMPInverseCDFTable::RowQuantile(G4int ipar, G4double r) const {
+  const G4double* row = &quantile[ipar*(nQuant+1)];
+
+  G4double t = r*nQuant;
+  G4int j = std::min(std::max(G4int(t), 0), nQuant-1);
+  G4double f = t - j;
+
+  return row[j] + f*(row[j+1]-row[j]);
+}
+
+G4double G4CMPInverseCDFTable::Sample(G4double par, G4double r) const {
+  if (nPar <= 0) return r;		// Uninitialized table is uniform
+  if (nPar == 1) return RowQuantile(0, r);
+
+  G4double t = (par-parMin)/parStep;
+  if (t <= 0.) return RowQuantile(0, r);
+  if (t >= nPar-1) return RowQuantile(nPar-1, r);
+
+  G4int ipar = G4int(t);
+  G4double f = t - ipar;
+  return ((1.-f)*RowQuantile(ipar, r) + f*RowQuantile(ipar+1, r));
+}
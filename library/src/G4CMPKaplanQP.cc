@@ -25,14 +25,102 @@
 //		a function.
 // 20201109  Add diagnostic text file (like downconversion and Luke).
 // 20221025  Protect diagnostic text file with verbosity inside G4CMP_DEBUG
+// 20261018  Sample QP and phonon energies from tabulated inverse CDFs,
+//		keeping rejection sampling outside of table range.
+// 20261018  Add optional response library, sampling stored cascades in
+//		place of full simulation; move cascade to DoCascade().
+// 20261018  Process cascade by generations using reusable work buffers,
+//		with random numbers and escape probabilities filled per
+//		generation rather than per phonon.
+// 20261018  Move G4CMP_DEBUG text file out of class, to compile out fully.
+// 20261018  Validate response library nodes on read; merge nodes from all
+//		threads into cache, written via temporary file.
+// 20261018  Debug text file is a per-thread stream, closed at thread end.
+// 20261018  Simulate cascades near 2*gap and lowQPLimit thresholds directly;
+//		write cache from SaveResponseLibrary(), not destructor.
 
 #include "globals.hh"
 #include "G4CMPKaplanQP.hh"
 #include "G4CMPConfigManager.hh"
+#include "G4CMPInverseCDFTable.hh"
+#include "G4AutoLock.hh"
 #include "G4MaterialPropertiesTable.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
 #include "Randomize.hh"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
 #include <numeric>
+#include <set>
+#include <sstream>
+#include <unistd.h>
+
+namespace {
+  G4Mutex cacheMutex = G4MUTEX_INITIALIZER;	// Serialize cache updates
+
+  // Instances on this thread, for SaveResponseLibraries(); deleted when
+  // last instance is
+  G4ThreadLocal std::set<G4CMPKaplanQP*>* threadInstances = 0;
+}
+
+#ifdef G4CMP_DEBUG
+namespace {
+  // Shared by thread's instances; opened on first verbose use, and
+  // closed when the thread ends
+  std::ofstream& DebugOutput() {
+    G4ThreadLocalStatic std::ofstream output;
+    return output;
+  }
+}
+#endif
+
+
+// Energy distributions in units of the gap, for building shared tables.
+// These are QPEnergyPDF() and PhononEnergyPDF() below with gapEnergy = 1,
+// on the same truncated ranges used for rejection sampling, with the
+// sampled energy mapped to u in [0,1].
+
+namespace {
+  const G4double BUFF = 1000.;	// Avoid zero denominators at endpoints
+
+  // Parameter is log(E/gap - 2)
+  struct QPEnergyShape {
+    G4double operator()(G4double par, G4double u) const {
+      G4double E = 2. + std::exp(par);
+      G4double xmin = 1. + (E-2.)/BUFF;
+      G4double xmax = 1. + (E-2.)*(BUFF-1.)/BUFF;
+      G4double x = xmin + u*(xmax-xmin);
+      return ( (x*(E-x) + 1.) / std::sqrt((x*x-1.) * ((E-x)*(E-x)-1.)) );
+    }
+  };
+
+  // Parameter is log(E/gap - 1)
+  struct PhononEnergyShape {
+    G4double operator()(G4double par, G4double u) const {
+      G4double E = 1. + std::exp(par);
+      G4double xmin = 1. + 1./BUFF;
+      G4double x = xmin + u*(E-xmin);
+      return ( x*(E-x)*(E-x) * (x-1./E) / std::sqrt(x*x - 1.) );
+    }
+  };
+
+  // Tables are independent of the film, so are built once and shared
+  const G4CMPInverseCDFTable& QPEnergyTable() {
+    static const G4CMPInverseCDFTable table(QPEnergyShape(), std::log(1e-3),
+					    std::log(1e5), 241);
+    return table;
+  }
+
+  const G4CMPInverseCDFTable& PhononEnergyTable() {
+    static const G4CMPInverseCDFTable table(PhononEnergyShape(), std::log(1e-2),
+					    std::log(1e5), 211);
+    return table;
+  }
+}
 
 
 // Global function for Kaplan quasiparticle downconversion.  Retained here
@@ -52,19 +140,49 @@ G4double G4CMP::KaplanPhononQP(G4double energy,
 }
 
 
+// Response library granularity; 20 nodes/decade is ~12% energy spacing.
+// Below ~10 gap energies a cascade is a few pair breakings, and whether
+// each QP radiates (lowQPLimit) or each phonon breaks a pair (2*gap)
+// depends on absolute energy, which node scaling would shift.
+
+const G4int G4CMPKaplanQP::responsePerDecade = 20;
+const G4int G4CMPKaplanQP::responseSamples = 128;
+const G4double G4CMPKaplanQP::responseMinGaps = 10.;
+
+// Work buffers grow as needed; this covers cascades up to ~100 meV in Al
+const size_t G4CMPKaplanQP::bufferReserve = 1024;
+
+
 // Class constructor and destructor
 
 G4CMPKaplanQP::G4CMPKaplanQP(G4MaterialPropertiesTable* prop, G4int vb)
   : verboseLevel(vb), filmProperties(0), filmThickness(0.), gapEnergy(0.),
     lowQPLimit(3.), subgapAbsorption(0.), phononLifetime(0.),
-    phononLifetimeSlope(0.), vSound(0.) {
+    phononLifetimeSlope(0.), vSound(0.),
+    useLibrary(G4CMPConfigManager::UseKaplanLibrary()),
+    libraryChanged(false) {
+  phonBuffer.reserve(bufferReserve);
+  qpBuffer.reserve(bufferReserve);
+  nextBuffer.reserve(bufferReserve);
+  randBuffer.reserve(2*bufferReserve);
+  probBuffer.reserve(bufferReserve);
+
   SetFilmProperties(prop);
+
+  if (!threadInstances) threadInstances = new std::set<G4CMPKaplanQP*>;
+  threadInstances->insert(this);
 }
 
 G4CMPKaplanQP::~G4CMPKaplanQP() {
-#ifdef G4CMP_DEBUG
-  if (output.is_open()) output.close();
-#endif
+  ClearResponseLibrary();		// Cache is written only on request
+
+  if (threadInstances) {
+    threadInstances->erase(this);
+    if (threadInstances->empty()) {
+      delete threadInstances;
+      threadInstances = 0;
+    }
+  }
 }
 
 // Configure thin film (QET, metalization, etc.) for phonon absorption
@@ -102,6 +220,10 @@ void G4CMPKaplanQP::SetFilmProperties(G4MaterialPropertiesTable* prop) {
 			? prop->GetConstProperty("subgapAbsorption") : 0.);
 
     filmProperties = prop;
+
+    // Response library is only valid for a specific configuration
+    if (!libraryKey.empty() && libraryKey != ResponseLibraryKey())
+      ClearResponseLibrary();
   }
 }
 
@@ -129,6 +251,7 @@ AbsorbPhonon(G4double energy, std::vector<G4double>& reflectedEnergies) const {
   }
 
 #ifdef G4CMP_DEBUG
+  std::ofstream& output = DebugOutput();
   if (verboseLevel && !output.is_open()) {
     output.open("kaplanqp_stats");
     if (!output.good()) {
@@ -158,10 +281,47 @@ AbsorbPhonon(G4double energy, std::vector<G4double>& reflectedEnergies) const {
 
   // Phonon goes into superconductor and gets partitioned into
   // quasiparticles, new phonons, and absorbed energy
+  G4double EDep = ((useLibrary && energy >= ResponseMinEnergy())
+		   ? SampleResponse(energy, reflectedEnergies)
+		   : DoCascade(energy, reflectedEnergies));
+
+  // Sanity check -- Reflected + Absorbed should equal input
+  G4double ERefl = std::accumulate(reflectedEnergies.begin(),
+				   reflectedEnergies.end(), 0.);
+  if (verboseLevel>1) {
+    G4cout << " Reflected " << ERefl << " (" << reflectedEnergies.size()
+	   << ")\n Absorbed " << EDep << G4endl;
+  }
+
+  if (fabs(energy-ERefl-EDep)/energy > 1e-3) {
+    G4cerr << "WARNING G4CMPKaplanQP missing " << (energy-ERefl-EDep)/eV
+	   << " eV" << G4endl;
+  }
+
+#ifdef G4CMP_DEBUG
+  if (output.is_open() && output.good()) {
+    output << energy/eV << "," << EDep/eV << "," << ERefl/eV << ","
+	   << reflectedEnergies.size() << std::endl;
+  }
+#endif
+
+  return EDep;
+}
+
+
+// Simulate the phonon/QP cascade for a phonon which has entered the film.
+// Each pass of the loop processes one complete generation of phonons and
+// quasiparticles, with the next generation swapped into the work buffers.
+
+G4double G4CMPKaplanQP::
+DoCascade(G4double energy, std::vector<G4double>& reflectedEnergies) const {
   G4double EDep = 0.;
 
-  std::vector<G4double> qpEnergies;
-  std::vector<G4double> phonEnergies{energy};
+  std::vector<G4double>& qpEnergies = qpBuffer;
+  std::vector<G4double>& phonEnergies = phonBuffer;
+  qpEnergies.clear();
+  phonEnergies.assign(1, energy);
+
   while (qpEnergies.size() > 0 || phonEnergies.size() > 0) {
     if (phonEnergies.size() > 0) {
       // Partition the phonons' energies into quasi-particles according to
@@ -181,27 +341,285 @@ AbsorbPhonon(G4double energy, std::vector<G4double>& reflectedEnergies) const {
     }
   }
 
-  // Sanity check -- Reflected + Absorbed should equal input
-  G4double ERefl = std::accumulate(reflectedEnergies.begin(),
-				   reflectedEnergies.end(), 0.);
+  return EDep;
+}
+
+
+// Pick one stored cascade from library, choosing between the nodes on
+// either side of the energy with linear weights, and scale to energy
+
+G4double G4CMPKaplanQP::
+SampleResponse(G4double energy, std::vector<G4double>& reflectedEnergies) const {
+  if (libraryKey.empty()) {		// First use for this film
+    libraryKey = ResponseLibraryKey();
+    LoadResponseLibrary(ResponseCacheFile(libraryKey));
+  }
+
+  G4double t = responsePerDecade * std::log10(energy/ResponseMinEnergy());
+  size_t inode = (t > 0.) ? size_t(t) : 0;
+  if (G4UniformRand() < t-inode) inode++;
+
+  if (inode >= responseLib.size() || responseLib[inode].absorbed.empty())
+    FillResponseNode(inode);
+
+  const ResponseNode& node = responseLib[inode];
+  size_t isamp = std::min(size_t(G4UniformRand()*node.absorbed.size()),
+			  node.absorbed.size()-1);
+
+  size_t last = (isamp+1 < node.first.size() ? node.first[isamp+1]
+		 : node.reflected.size());
+  for (size_t i=node.first[isamp]; i<last; i++) {
+    reflectedEnergies.push_back(node.reflected[i]*energy);
+  }
+
   if (verboseLevel>1) {
-    G4cout << " Reflected " << ERefl << " (" << reflectedEnergies.size()
-	   << ")\n Absorbed " << EDep << G4endl;
+    G4cout << " SampleResponse node " << inode << " sample " << isamp
+	   << " reflected " << last-node.first[isamp] << " phonons" << G4endl;
   }
 
-  if (fabs(energy-ERefl-EDep)/energy > 1e-3) {
-    G4cerr << "WARNING G4CMPKaplanQP missing " << (energy-ERefl-EDep)/eV
-	   << " eV" << G4endl;
+  return node.absorbed[isamp]*energy;
+}
+
+
+// Run cascades at node energy, storing results as fractions of energy
+
+void G4CMPKaplanQP::FillResponseNode(size_t inode) const {
+  if (inode >= responseLib.size()) responseLib.resize(inode+1);
+
+  G4double energy =
+    ResponseMinEnergy() * std::pow(10., G4double(inode)/responsePerDecade);
+  if (verboseLevel) {
+    G4cout << "G4CMPKaplanQP::FillResponseNode " << inode << " @ "
+	   << energy/eV << " eV" << G4endl;
   }
 
-#ifdef G4CMP_DEBUG
-  if (output.good()) {
-    output << energy/eV << "," << EDep/eV << "," << ERefl/eV << ","
-	   << reflectedEnergies.size() << std::endl;
+  ResponseNode& node = responseLib[inode];
+  node.absorbed.clear();
+  node.first.clear();
+  node.reflected.clear();
+
+  std::vector<G4double> cascadeRefl;
+  for (G4int i=0; i<responseSamples; i++) {
+    cascadeRefl.clear();
+    G4double EDep = DoCascade(energy, cascadeRefl);
+
+    node.absorbed.push_back(EDep/energy);
+    node.first.push_back(node.reflected.size());
+    for (const G4double& E: cascadeRefl) node.reflected.push_back(E/energy);
   }
-#endif
 
-  return EDep;
+  libraryChanged = true;
+}
+
+// Library must start far enough above both thresholds
+
+G4double G4CMPKaplanQP::ResponseMinEnergy() const {
+  return std::max(responseMinGaps, 4.*lowQPLimit) * gapEnergy;
+}
+
+
+// Save new nodes to cache file.  Every thread with new nodes merges them
+// with those already cached, so nodes filled on any worker are kept.
+// Concurrent jobs sharing the cache directory each replace the file whole;
+// the last one to finish wins.
+
+G4bool G4CMPKaplanQP::SaveResponseLibrary() const {
+  G4String cache = ResponseCacheFile(libraryKey);
+  if (!libraryChanged || cache.empty()) return false;
+
+  G4AutoLock cacheLock(&cacheMutex);
+  MergeResponseLibrary(cache);
+  libraryChanged = !WriteResponseLibrary(cache);
+
+  return !libraryChanged;
+}
+
+void G4CMPKaplanQP::SaveResponseLibraries() {
+  if (!threadInstances) return;
+
+  for (G4CMPKaplanQP* kaplan: *threadInstances) kaplan->SaveResponseLibrary();
+}
+
+
+// Discard library for previous film configuration; unsaved nodes are lost
+
+void G4CMPKaplanQP::ClearResponseLibrary() {
+  if (libraryChanged && verboseLevel) {
+    G4cout << "G4CMPKaplanQP: discarding response nodes not saved with"
+	   << " SaveResponseLibrary()" << G4endl;
+  }
+
+  responseLib.clear();
+  libraryChanged = false;
+  libraryKey = "";
+}
+
+
+// Library is only valid for exactly the same film parameters
+
+G4String G4CMPKaplanQP::ResponseLibraryKey() const {
+  std::ostringstream key;
+  key << responsePerDecade << " " << responseSamples << " " << responseMinGaps
+      << " "
+      << std::setprecision(8) << gapEnergy/eV << " " << filmThickness/nm
+      << " " << phononLifetime/ps << " " << phononLifetimeSlope
+      << " " << vSound/(m/s) << " " << lowQPLimit << " " << subgapAbsorption;
+  return key.str();
+}
+
+G4String G4CMPKaplanQP::ResponseCacheFile(const G4String& key) const {
+  const G4String& dir = G4CMPConfigManager::GetKaplanCacheDir();
+  if (dir.empty() || key.empty()) return "";
+
+  std::ostringstream name;
+  name << dir << "/KaplanQP_" << std::hex << std::hash<std::string>()(key)
+       << ".dat";
+  return name.str();
+}
+
+
+// Read and write library nodes, with film parameters for validation
+
+G4bool G4CMPKaplanQP::ReadResponseLibrary(const G4String& filename) {
+  ClearResponseLibrary();
+  libraryKey = ResponseLibraryKey();
+  return LoadResponseLibrary(filename);
+}
+
+G4bool G4CMPKaplanQP::LoadResponseLibrary(const G4String& filename) const {
+  responseLib.clear();
+  G4bool valid = ReadResponseNodes(filename, responseLib);
+
+  if (verboseLevel && !responseLib.empty()) {
+    G4cout << "G4CMPKaplanQP read " << responseLib.size() << " response nodes"
+	   << " from " << filename << G4endl;
+  }
+
+  return valid;
+}
+
+// Each node must have all of its cascades, each with the full list of
+// reflected phonons and conserving energy.  Damaged nodes (e.g., from a
+// truncated file) are left empty, so they are refilled when used.
+
+G4bool G4CMPKaplanQP::
+ReadResponseNodes(const G4String& filename,
+		  std::vector<ResponseNode>& nodes) const {
+  if (filename.empty()) return false;
+
+  std::ifstream in(filename);
+  if (!in.good()) return false;
+
+  std::string line;
+  std::getline(in, line);
+  if (line != "# G4CMPKaplanQP "+libraryKey) {
+    G4cerr << "G4CMPKaplanQP: " << filename << " is for different film"
+	   << " parameters; ignored." << G4endl;
+    return false;
+  }
+
+  size_t nBad = 0;
+  size_t inode, nsamp, nrefl;
+  G4double frac, Esum;
+  while (std::getline(in, line)) {
+    std::istringstream header(line);
+    if (!(header >> inode >> nsamp)) {	// Can't find next node; give up
+      nBad++;
+      break;
+    }
+
+    ResponseNode node;
+    G4bool good = (nsamp == size_t(responseSamples));
+    for (size_t i=0; i<nsamp; i++) {	// Read every line to stay in sync
+      if (!std::getline(in, line)) { good = false; break; }
+
+      std::istringstream sample(line);
+      if (!(sample >> frac >> nrefl)) { good = false; continue; }
+
+      node.absorbed.push_back(frac);
+      node.first.push_back(node.reflected.size());
+      Esum = frac;
+      for (size_t j=0; j<nrefl && sample >> frac; j++) {
+	node.reflected.push_back(frac);
+	Esum += frac;
+      }
+
+      if (node.reflected.size()-node.first.back() != nrefl ||
+	  fabs(Esum-1.) > 1e-3) good = false;
+    }
+
+    if (!good) {
+      nBad++;
+      continue;
+    }
+
+    if (inode >= nodes.size()) nodes.resize(inode+1);
+    nodes[inode] = std::move(node);
+  }
+
+  if (nBad > 0) {
+    G4cerr << "G4CMPKaplanQP: " << filename << " has " << nBad
+	   << " incomplete response nodes; they will be refilled." << G4endl;
+  }
+
+  return (nBad == 0);
+}
+
+// Take nodes from cache file (e.g., written by another thread) which are
+// not yet filled here
+
+void G4CMPKaplanQP::MergeResponseLibrary(const G4String& filename) const {
+  std::vector<ResponseNode> cached;
+  ReadResponseNodes(filename, cached);
+
+  if (cached.size() > responseLib.size()) responseLib.resize(cached.size());
+  for (size_t inode=0; inode<cached.size(); inode++) {
+    if (responseLib[inode].absorbed.empty() && !cached[inode].absorbed.empty())
+      responseLib[inode] = std::move(cached[inode]);
+  }
+}
+
+// Write to temporary file and rename it into place, so that a reader (or
+// a crash while writing) never leaves a partial cache file
+
+G4bool G4CMPKaplanQP::WriteResponseLibrary(const G4String& filename) const {
+  std::ostringstream tmpname;
+  tmpname << filename << ".tmp" << getpid() << "_"
+	  << G4Threading::G4GetThreadId();
+  G4String tmpfile = tmpname.str();
+
+  std::ofstream out(tmpfile);
+  if (!out.good()) {
+    G4cerr << "G4CMPKaplanQP: unable to write " << tmpfile << G4endl;
+    return false;
+  }
+
+  out << "# G4CMPKaplanQP "
+      << (libraryKey.empty() ? ResponseLibraryKey() : libraryKey) << "\n"
+      << std::setprecision(10);
+
+  for (size_t inode=0; inode<responseLib.size(); inode++) {
+    const ResponseNode& node = responseLib[inode];
+    if (node.absorbed.empty()) continue;
+
+    out << inode << " " << node.absorbed.size() << "\n";
+    for (size_t i=0; i<node.absorbed.size(); i++) {
+      size_t last = (i+1 < node.first.size() ? node.first[i+1]
+		     : node.reflected.size());
+      out << node.absorbed[i] << " " << last-node.first[i];
+      for (size_t j=node.first[i]; j<last; j++) out << " " << node.reflected[j];
+      out << "\n";
+    }
+  }
+
+  out.close();
+  if (out.fail() || std::rename(tmpfile.c_str(), filename.c_str()) != 0) {
+    G4cerr << "G4CMPKaplanQP: unable to write " << filename << G4endl;
+    std::remove(tmpfile.c_str());
+    return false;
+  }
+
+  return true;
 }
 
 
@@ -229,6 +647,42 @@ G4double G4CMPKaplanQP::CalcEscapeProbability(G4double energy,
   return std::exp(-2.* thicknessFrac * filmThickness/mfp);
 }
 
+// Escape probabilities for whole generation, without diagnostics, so that
+// the loop can be vectorized.  Phonons headed away from the substrate
+// (thicknessFrac = 1.5) have the cube of these values.
+
+void G4CMPKaplanQP::
+CalcEscapeProbabilities(const std::vector<G4double>& phonEnergies,
+			std::vector<G4double>& escapeProbs) const {
+  const size_t n = phonEnergies.size();
+  escapeProbs.resize(n);
+
+  if (gapEnergy <= 0.) {
+    std::fill(escapeProbs.begin(), escapeProbs.end(), 1.);
+    return;
+  }
+
+  const G4double* E = phonEnergies.data();
+  G4double* prob = escapeProbs.data();
+  const G4double scale = filmThickness / (vSound*phononLifetime);
+  const G4double slope = phononLifetimeSlope / gapEnergy;
+  const G4double offset = 1. - 2.*phononLifetimeSlope;
+
+  for (size_t i=0; i<n; i++) {
+    prob[i] = std::exp(-scale * (offset + slope*E[i]));
+  }
+}
+
+
+// Random numbers are drawn as a block for all energies in a generation
+
+const G4double* G4CMPKaplanQP::FillRandomBuffer(size_t n) const {
+  randBuffer.resize(n);
+  if (n > 0)
+    CLHEP::HepRandom::getTheEngine()->flatArray(G4int(n), randBuffer.data());
+  return randBuffer.data();
+}
+
 
 // Model the phonons (phonEnergies) breaking Cooper pairs into quasiparticles
 // (qpEnergies).
@@ -243,16 +697,21 @@ G4CMPKaplanQP::CalcQPEnergies(std::vector<G4double>& phonEnergies,
 
   // Phonons above the bandgap give all of its energy to the qp pair it breaks.
   G4double EDep = 0.;
-  std::vector<G4double> newPhonEnergies;
+  std::vector<G4double>& newPhonEnergies = nextBuffer;
+  newPhonEnergies.clear();
+
+  const size_t n = phonEnergies.size();
+  const G4double* rand = FillRandomBuffer(n);
 
-  for (const G4double& E: phonEnergies) {
+  for (size_t i=0; i<n; i++) {
+    const G4double E = phonEnergies[i];
     if (IsSubgap(E)) {
       if (verboseLevel>2) G4cout << " Skipping phononE " << E << G4endl;
       newPhonEnergies.push_back(E);
       continue;
     }
 
-    G4double qpE = QPEnergyRand(E);
+    G4double qpE = QPEnergyRand(E, rand[i]);
     if (verboseLevel>2) G4cout << " phononE " << E << " qpE " << qpE << G4endl;
 
     EDep += CalcQPAbsorption(qpE, newPhonEnergies, qpEnergies);
@@ -280,11 +739,17 @@ G4CMPKaplanQP::CalcPhononEnergies(std::vector<G4double>& phonEnergies,
 
   // Have a reference in for loop b/c qp doesn't give all of its energy away.
   G4double EDep = 0.;
-  std::vector<G4double> newQPEnergies;
-  for (const G4double& E: qpEnergies) {
+  std::vector<G4double>& newQPEnergies = nextBuffer;
+  newQPEnergies.clear();
+
+  const size_t n = qpEnergies.size();
+  const G4double* rand = FillRandomBuffer(n);
+
+  for (size_t i=0; i<n; i++) {
+    const G4double E = qpEnergies[i];
     if (verboseLevel>2) G4cout << " qpE " << E;		// Report before change
 
-    G4double phonE = PhononEnergyRand(E);
+    G4double phonE = PhononEnergyRand(E, rand[i]);
     G4double qpE = E - phonE;
     if (verboseLevel>2)
       G4cout << " phononE " << phonE << " qpE " << qpE << G4endl;
@@ -315,9 +780,17 @@ CalcReflectedPhononEnergies(std::vector<G4double>& phonEnergies,
   if (verboseLevel>1)
     G4cout << "G4CMPKaplanQP::CalcReflectedPhononEnergies " << G4endl;
 
+  std::vector<G4double>& newPhonEnergies = nextBuffer;
+  newPhonEnergies.clear();
+
+  // Probabilities and random numbers for direction and escape of each phonon
+  const size_t n = phonEnergies.size();
+  CalcEscapeProbabilities(phonEnergies, probBuffer);
+  const G4double* rand = FillRandomBuffer(2*n);
+
   // There is a 50% chance that a phonon is headed away from (toward) substrate
-  std::vector<G4double> newPhonEnergies;
-  for (const G4double& E: phonEnergies) {
+  for (size_t i=0; i<n; i++) {
+    const G4double E = phonEnergies[i];
     if (verboseLevel>2) G4cout << " phononE " << E << G4endl;
 
     // Phonons below the bandgap are unconditionally reflected
@@ -330,8 +803,9 @@ CalcReflectedPhononEnergies(std::vector<G4double>& phonEnergies,
     // frac = 1.5 for phonons headed away from the subst. 0.5 for toward.
     // This assumes that, on average, the phonons are spawned at the center
     // of the superconductor, which is likely not true.
-    G4double frac = (G4UniformRand() < 0.5 ? 0.5 : 1.5);
-    if (G4UniformRand() < CalcEscapeProbability(E, frac)) {
+    const G4double p = probBuffer[i];
+    const G4double pEscape = (rand[2*i] < 0.5 ? p : p*p*p);
+    if (rand[2*i+1] < pEscape) {
       if (verboseLevel>2) G4cout << " phononE got reflected" << G4endl;
       reflectedEnergies.push_back(E);
     } else {
@@ -390,8 +864,12 @@ G4CMPKaplanQP::CalcQPAbsorption(G4double qpE,
 // Compute quasiparticle energy distribution from broken Cooper pair.
 
 G4double G4CMPKaplanQP::QPEnergyRand(G4double Energy) const {
-  // PDF is not integrable, so we can't do an inverse transform sampling.
-  // Instead, we'll do a rejection method.
+  return QPEnergyRand(Energy, G4UniformRand());
+}
+
+G4double G4CMPKaplanQP::QPEnergyRand(G4double Energy, G4double rand) const {
+  // PDF is not integrable, so we use an inverse CDF tabulated numerically
+  // (see QPEnergyShape above), or a rejection method outside of the table.
   //
   // PDF(E') = (E'*(Energy - E') + gapEnergy*gapEnergy)
   //           /
@@ -401,9 +879,15 @@ G4double G4CMPKaplanQP::QPEnergyRand(G4double Energy) const {
   // E' = gapEnergy and E' = Energy - gapEnergy
 
   // Add buffer so first/last bins don't give zero denominator in pdfSum
-  const G4double BUFF = 1000.;
   G4double xmin = gapEnergy + (Energy-2.*gapEnergy)/BUFF;
   G4double xmax = gapEnergy + (Energy-2.*gapEnergy)*(BUFF-1.)/BUFF;
+  if (xmax <= xmin) return xmin;		// Pair at threshold
+
+  G4double par = std::log(Energy/gapEnergy - 2.);
+  const G4CMPInverseCDFTable& table = QPEnergyTable();
+  if (table.InRange(par))
+    return xmin + table.Sample(par, rand)*(xmax-xmin);
+
   G4double ymax = QPEnergyPDF(Energy, xmin);
 
   G4double xtest=0., ytest=ymax;
@@ -424,17 +908,27 @@ G4double G4CMPKaplanQP::QPEnergyPDF(G4double E, G4double x) const {
 // Compute phonon energy distribution from quasiparticle in superconductor.
 
 G4double G4CMPKaplanQP::PhononEnergyRand(G4double Energy) const {
-  // PDF is not integrable, so we can't do an inverse transform sampling.
-  // Instead, we'll do a rejection method.
+  return PhononEnergyRand(Energy, G4UniformRand());
+}
+
+G4double G4CMPKaplanQP::PhononEnergyRand(G4double Energy, G4double rand) const {
+  // PDF is not integrable, so we use an inverse CDF tabulated numerically
+  // (see PhononEnergyShape above), or a rejection method outside of the
+  // table.
   //
   // PDF(E') = (E'*(Energy-E')*(Energy-E') * (E'-gapEnergy*gapEnergy/Energy))
   //           /
   //           sqrt((E'*E' - gapEnergy*gapEnergy);
 
   // Add buffer so first bin doesn't give zero denominator in pdfSum
-  const G4double BUFF = 1000.;
   G4double xmin = gapEnergy + gapEnergy/BUFF;
   G4double xmax = Energy;
+
+  G4double par = std::log(Energy/gapEnergy - 1.);
+  const G4CMPInverseCDFTable& table = PhononEnergyTable();
+  if (table.InRange(par))
+    return Energy - (xmin + table.Sample(par, rand)*(xmax-xmin));
+
   G4double ymax = PhononEnergyPDF(Energy, xmin);
 
   G4double xtest=0., ytest=ymax;
@@ -0,0 +1,155 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/src/G4CMPLambertianTable.cc
+/// \brief Implementation of the G4CMPLambertianTable class, for sampling
+///	   diffuse phonon reflection restricted to inward group velocity.
+//
+// 20261018  New class for rejection-free diffuse phonon reflection
+// 20261018  Move per-thread cache to G4CMPSurfaceTableCache
+// 20261018  Fall back to surface normal if no inward trial is found
+
+#include "G4CMPLambertianTable.hh"
+#include "G4CMPConfigManager.hh"
+#include "G4CMPSurfaceTableCache.hh"
+#include "G4LatticePhysical.hh"
+#include "G4PhysicalConstants.hh"
+#include "Randomize.hh"
+#include <algorithm>
+#include <cmath>
+
+
+// Grid granularity; 2x2 probes in 32x64 cells is ~8000 kinematic lookups
+
+const G4int G4CMPLambertianTable::nS = 32;
+const G4int G4CMPLambertianTable::nPhi = 64;
+const G4int G4CMPLambertianTable::nProbe = 2;
+const G4int G4CMPLambertianTable::maxTries = 1000;
+
+
+// Per-thread cache of tables, keyed by lattice, mode and rounded normal
+
+const G4CMPLambertianTable*
+G4CMPLambertianTable::GetTable(const G4LatticePhysical* lat, G4int mode,
+			       const G4ThreeVector& surfNorm) {
+  return G4CMPSurfaceTableCache<G4CMPLambertianTable>::GetTable(lat, mode,
+								surfNorm);
+}
+
+
+// Constructor
+
+G4CMPLambertianTable::G4CMPLambertianTable(const G4LatticePhysical* lat,
+					   G4int theMode,
+					   const G4ThreeVector& surfNorm)
+  : lattice(lat), mode(theMode) {
+  FillEnvelope(surfNorm);
+
+  if (G4CMPConfigManager::GetVerboseLevel() > 1) {
+    G4cout << "G4CMPLambertianTable mode " << mode << " normal " << surfNorm
+	   << " envelope " << GetEnvelopeFraction() << G4endl;
+  }
+}
+
+
+// Probe each cell and collect those which may contain inward directions
+
+void G4CMPLambertianTable::FillEnvelope(const G4ThreeVector& surfNorm) {
+  const G4int nCell = nS*nPhi;
+  std::vector<G4int> nInward(nCell, 0);
+
+  for (G4int is=0; is<nS; is++) {
+    for (G4int iphi=0; iphi<nPhi; iphi++) {
+      for (G4int a=0; a<nProbe; a++) {
+	for (G4int b=0; b<nProbe; b++) {
+	  G4double s = (is + (a+0.5)/nProbe) / nS;
+	  G4double phi = twopi * (iphi + (b+0.5)/nProbe) / nPhi;
+	  if (IsInward(Direction(surfNorm, s, phi), surfNorm))
+	    nInward[is*nPhi+iphi]++;
+	}
+      }
+    }
+  }
+
+  // Cells bordering a partially accepted cell may contain part of the
+  // boundary between probes, so are included as well
+  std::vector<G4bool> keep(nCell, false);
+  for (G4int is=0; is<nS; is++) {
+    for (G4int iphi=0; iphi<nPhi; iphi++) {
+      G4int n = nInward[is*nPhi+iphi];
+      if (n == 0) continue;
+
+      keep[is*nPhi+iphi] = true;
+      if (n == nProbe*nProbe) continue;
+
+      for (G4int js=std::max(is-1,0); js<=std::min(is+1,nS-1); js++) {
+	for (G4int dphi=-1; dphi<=1; dphi++) {
+	  keep[js*nPhi + (iphi+dphi+nPhi)%nPhi] = true;
+	}
+      }
+    }
+  }
+
+  envelope.clear();
+  for (G4int i=0; i<nCell; i++) {
+    if (keep[i]) envelope.push_back(i);
+  }
+}
+
+
+// Sample uniformly within envelope cells, testing each trial exactly.
+// Wavevector along -surfNorm always has inward group velocity (v.k > 0),
+// so it is used if no trial succeeds.
+
+G4ThreeVector
+G4CMPLambertianTable::Sample(const G4ThreeVector& surfNorm) const {
+  if (envelope.empty()) return -surfNorm;
+
+  for (G4int i=0; i<maxTries; i++) {
+    size_t icell = std::min(size_t(G4UniformRand()*envelope.size()),
+			    envelope.size()-1);
+    G4int is = envelope[icell] / nPhi;
+    G4int iphi = envelope[icell] % nPhi;
+
+    G4double s = (is + G4UniformRand()) / nS;
+    G4double phi = twopi * (iphi + G4UniformRand()) / nPhi;
+
+    G4ThreeVector kdir = Direction(surfNorm, s, phi);
+    if (IsInward(kdir, surfNorm)) return kdir;
+  }
+
+  G4ExceptionDescription msg;
+  msg << "No inward direction for mode " << mode << " at " << surfNorm
+      << " after " << maxTries << " tries; using surface normal.";
+  G4Exception("G4CMPLambertianTable::Sample", "Boundary011", JustWarning, msg);
+
+  return -surfNorm;
+}
+
+G4double G4CMPLambertianTable::GetEnvelopeFraction() const {
+  return G4double(envelope.size()) / (nS*nPhi);
+}
+
+
+// Lambertian distribution is uniform in s = sin^2(theta) and phi
+
+G4ThreeVector G4CMPLambertianTable::Direction(const G4ThreeVector& surfNorm,
+					      G4double s, G4double phi) const {
+  G4ThreeVector e1 = surfNorm.orthogonal().unit();
+  G4ThreeVector e2 = surfNorm.cross(e1);
+
+  G4double sinTheta = std::sqrt(s);
+  G4double cosTheta = std::sqrt(1.-s);
+
+  return (-cosTheta*surfNorm
+	  + sinTheta*(std::cos(phi)*e1 + std::sin(phi)*e2));
+}
+
+// Same test as G4CMP::PhononVelocityIsInward()
+
+G4bool G4CMPLambertianTable::IsInward(const G4ThreeVector& kdir,
+				      const G4ThreeVector& surfNorm) const {
+  return lattice->MapKtoVDir(mode, kdir).dot(surfNorm) < 0.;
+}
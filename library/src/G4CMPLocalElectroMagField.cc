@@ -10,6 +10,7 @@
 //
 // 20180711  Provide interpolator to return potential at point in volume,
 //	       assuming "mid-plane" is at ground.
+// 20261018  Add query for uniform field, to select exact stepper
 
 #include "G4CMPLocalElectroMagField.hh"
 #include "G4CMPMeshElectricField.hh"
@@ -141,3 +142,10 @@ GetPotential(const G4double Point[4]) const {
   // Arbitrary field configurations must be integrated
   return 0.;
 }
+
+
+// Uniform fields may be propagated analytically, see G4CMPFieldManager
+
+G4bool G4CMPLocalElectroMagField::IsUniformField() const {
+  return (dynamic_cast<const G4UniformElectricField*>(localField) != 0);
+}
@@ -14,8 +14,10 @@
 //
 // 20220331  G4CMP-294:  Protect against null surfaceTable pointer
 // 20220718  G4CMP-306:  Ensure build compatibility with Geant4-10.04
+// 20261018  Discard shared G4CMPSurfaceLookup when registry changes
 
 #include "G4CMPLogicalBorderSurface.hh"
+#include "G4CMPSurfaceLookup.hh"
 #include "G4ExceptionSeverity.hh"
 #include "G4LogicalSurface.hh"
 #include "G4VPhysicalVolume.hh"
@@ -64,11 +66,13 @@ void G4CMPLogicalBorderSurface::SetVolumes(G4VPhysicalVolume* vol1,
 void G4CMPLogicalBorderSurface::RemoveFromTable() {
   if (surfaceTable)
     surfaceTable->erase(G4CMPLogicalBorderKey(Volume1,Volume2));
+  G4CMPSurfaceLookup::Invalidate();
 }
 
 void G4CMPLogicalBorderSurface::AddToTable() {
   if (!surfaceTable) GetSurfaceTable();
   (*surfaceTable)[G4CMPLogicalBorderKey(Volume1,Volume2)] = this;
+  G4CMPSurfaceLookup::Invalidate();
 }
 
 
@@ -93,6 +97,7 @@ void G4CMPLogicalBorderSurface::CleanSurfaceTable() {
   }
 
   surfaceTable->clear();
+  G4CMPSurfaceLookup::Invalidate();
 }
 
 
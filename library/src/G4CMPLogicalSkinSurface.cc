@@ -13,8 +13,10 @@
 // Adapted from G4LogicalSkinSurface for phonon/charge carrier transport
 //
 // 20220331  G4CMP-294:  Protect against null surfaceTable pointer
+// 20261018  Discard shared G4CMPSurfaceLookup when registry changes
 
 #include"G4CMPLogicalSkinSurface.hh"
+#include "G4CMPSurfaceLookup.hh"
 #include "G4LogicalVolume.hh"
 
 
@@ -58,11 +60,13 @@ void G4CMPLogicalSkinSurface::SetLogicalVolume(G4LogicalVolume* vol) {
 
 void G4CMPLogicalSkinSurface::RemoveFromTable() {
   if (surfaceTable) surfaceTable->erase(LogVolume);
+  G4CMPSurfaceLookup::Invalidate();
 }
 
 void G4CMPLogicalSkinSurface::AddToTable() {
   if (!surfaceTable) GetSurfaceTable();
   (*surfaceTable)[LogVolume] = this;
+  G4CMPSurfaceLookup::Invalidate();
 }
 
 
@@ -86,6 +90,7 @@ void G4CMPLogicalSkinSurface::CleanSurfaceTable() {
   }
 
   surfaceTable->clear();
+  G4CMPSurfaceLookup::Invalidate();
 }
 
 
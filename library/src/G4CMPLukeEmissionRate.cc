@@ -11,6 +11,8 @@
 // 20170815  Drop call to LoadDataForTrack(); now handled in process.
 // 20170913  Check for electric field; compute "rate" to get up to Vsound
 // 20170917  Add interface for threshold identification
+// 20261018  Compute rate from G4CMPRateContext, not from track
+// 20261018  Use G4CMP::ChargeCarrierTimeStep() with lattice from context
 
 #include "G4CMPLukeEmissionRate.hh"
 #include "G4CMPGeometryUtils.hh"
@@ -25,33 +27,36 @@
 
 // Scattering rate is computed from electric field
 
-G4double G4CMPLukeEmissionRate::Rate(const G4Track& aTrack) const {
+G4double G4CMPLukeEmissionRate::Rate(const G4CMPRateContext& ctx) const {
   // Sanity check -- IsApplicable() should protect against this
-  if (!G4CMP::IsChargeCarrier(aTrack)) {
+  if (!G4CMP::IsChargeCarrier(ctx.particle)) {
     G4Exception("G4CMPLukeEmissionRate::Rate", "Luke001", EventMustBeAborted, 
-		("Invalid particle "+aTrack.GetDefinition()->GetParticleName()).c_str());
+		("Invalid particle "+ctx.particle->GetParticleName()).c_str());
     return 0.;
   }
 
-  G4double kmag = 0.; G4double l0 = 0.; G4double mass = 0.;
-  if (G4CMP::IsElectron(aTrack)) {
-    kmag = theLattice->MapV_elToK_HV(GetValleyIndex(aTrack),
-				     GetLocalVelocityVector(aTrack)).mag();
-    l0 = theLattice->GetElectronScatter();
-    mass = theLattice->GetElectronMass();	// Scalar mass
-  } else if (G4CMP::IsHole(aTrack)) {
-    kmag = GetLocalWaveVector(aTrack).mag();
-    l0 = theLattice->GetHoleScatter();
-    mass = theLattice->GetHoleMass();
+  const G4LatticePhysical* lat = ctx.lattice;	// For convenience below
+
+  // NOTE:  For holes, kHV is the same as the local wavevector
+  G4double kmag = ctx.kHV.mag();
+  G4double l0 = 0.; G4double mass = 0.;
+  if (G4CMP::IsElectron(ctx.particle)) {
+    l0 = lat->GetElectronScatter();
+    mass = lat->GetElectronMass();	// Scalar mass
+  } else if (G4CMP::IsHole(ctx.particle)) {
+    l0 = lat->GetHoleScatter();
+    mass = lat->GetHoleMass();
   }
 
   if (verboseLevel > 1) 
     G4cout << "LukeEmissionRate kmag = " << kmag*m << " /m" << G4endl;
 
-  G4double kSound = theLattice->GetSoundSpeed() * mass / hbar_Planck;
+  G4double vSound = lat->GetSoundSpeed();
+  G4double kSound = vSound * mass / hbar_Planck;
+  if (kmag <= kSound) return 0.;
 
   // Time step corresponding to Mach number (avg. time between radiations)
-  return (kmag > kSound) ? 1./ChargeCarrierTimeStep(kmag/kSound, l0) : 0.;
+  return 1./G4CMP::ChargeCarrierTimeStep(lat, kmag/kSound, l0);
 }
 
 
@@ -31,6 +31,8 @@
 //		closest to momentum direction.  Commented out now, as it leads
 //		to non-physical reduction of total Luke emission.
 // 20220907  G4CMP-316 -- Pass track into CreatePhonon instead of touchable.
+// 20261018  Suppress own MFP when G4CMPTimeStepper uses uniformization.
+// 20261018  Take Luke sampling from G4CMPSamplingContext.
 
 #include "G4CMPLukeScattering.hh"
 #include "G4CMPConfigManager.hh"
@@ -38,6 +40,7 @@
 #include "G4CMPDriftHole.hh"
 #include "G4CMPDriftTrackInfo.hh"
 #include "G4CMPLukeEmissionRate.hh"
+#include "G4CMPSamplingContext.hh"
 #include "G4CMPSecondaryUtils.hh"
 #include "G4CMPTrackUtils.hh"
 #include "G4CMPUtils.hh"
@@ -71,6 +74,20 @@ G4CMPLukeScattering::~G4CMPLukeScattering() {
 }
 
 
+// With uniformization, emission is triggered by G4CMPTimeStepper
+
+G4double G4CMPLukeScattering::GetMeanFreePath(const G4Track& track,
+					      G4double prevStep,
+					      G4ForceCondition* cond) {
+  if (G4CMPConfigManager::UseUniformization()) {
+    *cond = NotForced;
+    return DBL_MAX;
+  }
+
+  return G4CMPVProcess::GetMeanFreePath(track, prevStep, cond);
+}
+
+
 // Physics
 
 G4VParticleChange* G4CMPLukeScattering::PostStepDoIt(const G4Track& aTrack,
@@ -316,8 +333,8 @@ G4VParticleChange* G4CMPLukeScattering::PostStepDoIt(const G4Track& aTrack,
 
   // Create real phonon to be propagated, with random polarization
   // If phonon is not created, register the energy as deposited
-  G4double weight =
-    G4CMP::ChoosePhononWeight(G4CMPConfigManager::GetLukeSampling());
+  G4double lukeSample = G4CMPSamplingContext::Current().GetLukeSampling();
+  G4double weight = G4CMP::ChoosePhononWeight(lukeSample);
   if (weight > 0.) {
     G4Track* phonon = G4CMP::CreatePhonon(aTrack,
 					  G4PhononPolarization::UNKNOWN,
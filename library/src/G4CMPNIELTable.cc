@@ -0,0 +1,204 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/src/G4CMPNIELTable.cc
+/// \brief Implementation of the G4CMPNIELTable class, for interpolated
+///	   NIEL partition yields.
+//
+// 20261018  New class for tabulated NIEL partition yields
+// 20261018  Release tables when NIEL function is replaced; free caches
+
+#include "G4CMPNIELTable.hh"
+#include "G4AutoLock.hh"
+#include "G4CMPConfigManager.hh"
+#include "G4Material.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4VNIELPartition.hh"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <float.h>
+#include <map>
+#include <vector>
+
+
+// Nuclear recoils of interest are well within 10 eV to 100 MeV
+
+const G4double G4CMPNIELTable::Emin = 10.*eV;
+const G4double G4CMPNIELTable::Emax = 100.*MeV;
+const G4int G4CMPNIELTable::minPerDecade = 16;
+const G4int G4CMPNIELTable::maxPerDecade = 1024;
+const G4double G4CMPNIELTable::maxError = 1e-5;
+const size_t G4CMPNIELTable::maxTables = 256;
+
+
+// Registry of tables shared by all threads, with per-thread lookup cache
+
+namespace {
+  G4Mutex nielMutex = G4MUTEX_INITIALIZER;	// For thread protection
+
+  struct Key {
+    const G4VNIELPartition* niel;
+    const G4Material* material;
+    G4double Z, A;
+
+    G4bool operator<(const Key& rhs) const {
+      if (niel != rhs.niel) return niel < rhs.niel;
+      if (material != rhs.material) return material < rhs.material;
+      if (Z != rhs.Z) return Z < rhs.Z;
+      return A < rhs.A;
+    }
+  };
+
+  typedef std::map<Key, const G4CMPNIELTable*> TableMap;
+
+  // Released tables are kept until end of job, since other threads may
+  // still be reading them; all tables are deleted at exit
+  struct Registry {
+    TableMap tables;
+    std::vector<const G4CMPNIELTable*> released;
+
+    ~Registry() {
+      for (auto& entry: tables) delete entry.second;
+      for (auto table: released) delete table;
+    }
+  } sharedTables;
+
+  std::atomic<G4int> generation(0);	// Incremented when tables released
+
+  // Per-thread lookup, discarded when shared tables are released
+  struct ThreadCache {
+    TableMap tables;
+    G4int generation;
+    ThreadCache() : generation(0) {;}
+  };
+}
+
+const G4CMPNIELTable*
+G4CMPNIELTable::GetTable(const G4VNIELPartition* niel, const G4Material* mat,
+			 G4double Z, G4double A) {
+  if (!niel || !mat) return 0;
+
+  G4ThreadLocalStatic ThreadCache cache;	// Freed at end of thread
+
+  G4int current = generation.load();
+  if (cache.generation != current) {
+    cache.tables.clear();
+    cache.generation = current;
+  }
+
+  Key key = { niel, mat, Z, A };
+  TableMap::const_iterator it = cache.tables.find(key);
+  if (it == cache.tables.end()) {
+    G4AutoLock nielLock(&nielMutex);	// Protect before changing registry
+
+    TableMap& shared = sharedTables.tables;
+    it = shared.find(key);
+    if (it == shared.end()) {
+      const G4CMPNIELTable* table = 0;
+      if (shared.size() < maxTables)
+	table = new G4CMPNIELTable(niel, mat, Z, A);
+      it = shared.insert(std::make_pair(key, table)).first;
+    }
+
+    it = cache.tables.insert(*it).first;
+  }
+
+  return (it->second && it->second->IsValid()) ? it->second : 0;
+}
+
+void G4CMPNIELTable::ReleaseTables(const G4VNIELPartition* niel) {
+  if (!niel) return;
+
+  G4AutoLock nielLock(&nielMutex);
+
+  TableMap& shared = sharedTables.tables;
+  for (TableMap::iterator it = shared.begin(); it != shared.end(); ) {
+    if (it->first.niel == niel) {
+      if (it->second) sharedTables.released.push_back(it->second);
+      it = shared.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  generation++;				// Other threads must drop their caches
+}
+
+
+// Constructor
+
+G4CMPNIELTable::G4CMPNIELTable(const G4VNIELPartition* niel,
+			       const G4Material* mat, G4double Z, G4double A)
+  : nielFunc(niel), material(mat), projZ(Z), projA(A),
+    lnStep(0.), invStep(0.) {
+  FillTable();
+
+  if (G4CMPConfigManager::GetVerboseLevel() > 1) {
+    G4cout << "G4CMPNIELTable " << material->GetName() << " Z " << projZ
+	   << " A " << projA << " " << yield.size() << " points"
+	   << (IsValid() ? "" : " (not used)") << G4endl;
+  }
+}
+
+
+// Refine grid until midpoint interpolation error is within tolerance
+
+void G4CMPNIELTable::FillTable() {
+  G4double lnEmin = std::log(Emin);
+  G4double decades = std::log10(Emax/Emin);
+
+  for (G4int perDecade=minPerDecade; perDecade<=maxPerDecade; perDecade*=2) {
+    size_t nStep = size_t(std::ceil(decades*perDecade));
+    lnStep = std::log(Emax/Emin) / nStep;
+    invStep = 1./lnStep;
+
+    yield.resize(nStep+1);
+    for (size_t i=0; i<=nStep; i++) {
+      yield[i] = Evaluate(std::exp(lnEmin + i*lnStep));
+      if (!std::isfinite(yield[i])) {		// Can't be interpolated
+	yield.clear();
+	return;
+      }
+    }
+
+    if (MaxMidpointError() <= maxError) return;
+  }
+
+  yield.clear();			// Could not meet tolerance
+}
+
+G4double G4CMPNIELTable::MaxMidpointError() const {
+  G4double lnEmin = std::log(Emin);
+
+  G4double maxDiff = 0.;
+  for (size_t i=0; i+1<yield.size(); i++) {
+    G4double interp = 0.5*(yield[i] + yield[i+1]);
+    G4double exact = Evaluate(std::exp(lnEmin + (i+0.5)*lnStep));
+    if (!std::isfinite(exact)) return DBL_MAX;
+
+    maxDiff = std::max(maxDiff, std::fabs(interp-exact));
+  }
+
+  return maxDiff;
+}
+
+
+// Linear interpolation in log(E), or direct evaluation outside of table
+
+G4double G4CMPNIELTable::GetYield(G4double energy) const {
+  if (yield.empty() || energy < Emin || energy >= Emax)
+    return Evaluate(energy);
+
+  G4double u = std::log(energy/Emin) * invStep;
+  size_t i = std::min(size_t(u), yield.size()-2);
+  G4double f = u - i;
+
+  return yield[i] + f*(yield[i+1]-yield[i]);
+}
+
+G4double G4CMPNIELTable::Evaluate(G4double energy) const {
+  return nielFunc->PartitionNIEL(energy, material, projZ, projA);
+}
@@ -28,12 +28,18 @@
 // 20220712  M. Kelsey -- Pass process pointer to G4CMPAnharmonicDecay
 // 20220905  G4CMP-310 -- Add increments of kPerp to avoid bad reflections.
 // 20220910  G4CMP-299 -- Use fabs(k) in absorption test.
+// 20261018  Use tabulated inward region for diffuse reflection.
+// 20261018  Correct specular reflection from table before iterating.
+// 20261018  Use typed surface data and tabulated reflection probabilities.
+// 20261018  Refresh surface data from BuildPhysicsTable()
 
 #include "G4CMPPhononBoundaryProcess.hh"
 #include "G4CMPAnharmonicDecay.hh"
 #include "G4CMPConfigManager.hh"
 #include "G4CMPGeometryUtils.hh"
 #include "G4CMPPhononTrackInfo.hh"
+#include "G4CMPSpecularTable.hh"
+#include "G4CMPSurfaceLookup.hh"
 #include "G4CMPSurfaceProperty.hh"
 #include "G4CMPTrackUtils.hh"
 #include "G4CMPUtils.hh"
@@ -63,6 +69,14 @@ G4CMPPhononBoundaryProcess::~G4CMPPhononBoundaryProcess() {
 }
 
 
+// Surface data is read by all worker threads; fill it once on master
+
+void G4CMPPhononBoundaryProcess::
+BuildPhysicsTable(const G4ParticleDefinition&) {
+  G4CMPSurfaceLookup::UpdateSurfaceData();
+}
+
+
 // Configure for current track including AnharmonicDecay utility
 
 void G4CMPPhononBoundaryProcess::LoadDataForTrack(const G4Track* track) {
@@ -116,7 +130,7 @@ G4CMPPhononBoundaryProcess::PostStepDoIt(const G4Track& aTrack,
 
 G4bool G4CMPPhononBoundaryProcess::AbsorbTrack(const G4Track& aTrack,
                                                const G4Step& aStep) const {
-  G4double absMinK = GetMaterialProperty("absMinK");
+  G4double absMinK = surfData->absMinK;
   G4ThreeVector k = G4CMP::GetTrackInfo<G4CMPPhononTrackInfo>(aTrack)->k();
 
   if (verboseLevel>1) {
@@ -160,18 +174,12 @@ DoReflection(const G4Track& aTrack, const G4Step& aStep,
   }
 
   G4double freq = GetKineticEnergy(aTrack)/h_Planck;	// E = hf, f = E/h
-  G4double specProb = surfProp->SpecularReflProb(freq);
-  G4double diffuseProb = surfProp->DiffuseReflProb(freq);
-  G4double downconversionProb = surfProp->AnharmonicReflProb(freq);
+  G4double specProb, diffuseProb, downconversionProb;
 
   // Empirical functions may lead to non normalised probabilities.
-  // Normalise here.
-
-  G4double norm = specProb + diffuseProb + downconversionProb;
-
-  specProb /= norm;
-  diffuseProb /= norm;
-  downconversionProb /= norm;
+  // Table is filled with normalised values by G4CMPSurfaceProperty.
+  surfData->GetReflectionProbs(freq, downconversionProb, specProb,
+			       diffuseProb);
 
   G4ThreeVector reflectedKDir;
 
@@ -268,6 +276,17 @@ GetReflectedVector(const G4ThreeVector& waveVector,
 
   // Reflection didn't work as expected, need to correct   
 
+  // Tabulated correction for this surface, refined with one Newton step
+  const G4CMPSpecularTable* table =
+    G4CMPSpecularTable::GetTable(theLattice, mode, surfNorm);
+  if (table && table->Correct(reflectedKDir, surfNorm)) {
+    if (verboseLevel>2)
+      G4cout << " corrected specular reflection from table" << G4endl;
+
+    return reflectedKDir;
+  }
+
+  // Otherwise, step kPerp until momentum direction is inward
   // Watch how momentum direction changes with each kPerp step
   G4ThreeVector olddir, newdir;
   
@@ -306,14 +325,5 @@ GetReflectedVector(const G4ThreeVector& waveVector,
 
 G4ThreeVector G4CMPPhononBoundaryProcess::
 GetLambertianVector(const G4ThreeVector& surfNorm, G4int mode) const {
-  G4ThreeVector reflectedKDir;
-  const G4int maxTries = 1000;
-  G4int nTries = 0;
-  do {
-    reflectedKDir = G4CMP::LambertReflection(surfNorm);
-  } while (nTries++ < maxTries &&
-	   !G4CMP::PhononVelocityIsInward(theLattice, mode,
-					  reflectedKDir, surfNorm));
-
-  return reflectedKDir;
+  return G4CMP::LambertReflection(theLattice, mode, surfNorm);
 }
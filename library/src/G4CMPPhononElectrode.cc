@@ -29,6 +29,11 @@
 // directly absorb phonons below 2*bandgap.
 // 
 // 20221006  M. Kelsey -- Adapted from SuperCDMS simulation version
+// 20261018  Use tabulated inward region for diffuse re-emission.
+// 20261018  Cache film absorption probability on first use.
+// 20261018  Build film model when table is assigned, and for each clone,
+//		so that each thread has its own instance ready before use.
+// 20261018  Create re-emitted phonons as a batch, with reusable buffers.
 
 #include "G4CMPPhononElectrode.hh"
 #include "G4CMPGeometryUtils.hh"
@@ -48,19 +53,72 @@
 #include "Randomize.hh"
 
 
-// Constructor and destructor
+// Secondary buffer covers re-emission from most absorbed phonons
+
+const size_t G4CMPPhononElectrode::secondaryReserve = 256;
+
+
+// Constructors and destructor
 
 G4CMPPhononElectrode::G4CMPPhononElectrode()
-  : G4CMPVElectrodePattern(), kaplanQP(0) {;}
+  : G4CMPVElectrodePattern(), kaplanQP(0), filmAbsorption(-1.) {
+  phononEnergies.reserve(secondaryReserve);
+  phononModes.reserve(secondaryReserve);
+  phononWaveVecs.reserve(secondaryReserve);
+  phononTracks.reserve(secondaryReserve);
+}
+
+G4CMPPhononElectrode::G4CMPPhononElectrode(const G4CMPPhononElectrode& rhs)
+  : G4CMPVElectrodePattern(rhs), kaplanQP(0),
+    filmAbsorption(rhs.filmAbsorption) {
+  phononEnergies.reserve(secondaryReserve);
+  phononModes.reserve(secondaryReserve);
+  phononWaveVecs.reserve(secondaryReserve);
+  phononTracks.reserve(secondaryReserve);
+  BuildFilmModel();
+}
 
 G4CMPPhononElectrode::~G4CMPPhononElectrode() {
   delete kaplanQP; kaplanQP=0;
 }
 
+
+// Create film model when table is assigned, rather than at first phonon
+
+void
+G4CMPPhononElectrode::UseSurfaceTable(G4MaterialPropertiesTable* surfProp) {
+  G4CMPVElectrodePattern::UseSurfaceTable(surfProp);
+  filmAbsorption = -1.;
+  BuildFilmModel();
+}
+
+// NOTE:  Film properties may be added to table after electrode is set, in
+//	  which case the model is created at first use
+
+void G4CMPPhononElectrode::BuildFilmModel() {
+  delete kaplanQP; kaplanQP=0;
+  if (!theSurfaceTable) return;
+
+  if (theSurfaceTable->ConstPropertyExists("filmThickness") &&
+      theSurfaceTable->ConstPropertyExists("gapEnergy") &&
+      theSurfaceTable->ConstPropertyExists("phononLifetime") &&
+      theSurfaceTable->ConstPropertyExists("phononLifetimeSlope") &&
+      theSurfaceTable->ConstPropertyExists("vSound")) {
+    kaplanQP = new G4CMPKaplanQP(theSurfaceTable, verboseLevel);
+  }
+
+  if (theSurfaceTable->ConstPropertyExists("filmAbsorption"))
+    filmAbsorption = theSurfaceTable->GetConstProperty("filmAbsorption");
+}
+
+
 // Assumes that user has configured a border surface only at sensor pads
 
 G4bool G4CMPPhononElectrode::IsNearElectrode(const G4Step& /*step*/) const {
-  return G4UniformRand() < GetMaterialProperty("filmAbsorption");
+  if (filmAbsorption < 0.)
+    filmAbsorption = GetMaterialProperty("filmAbsorption");
+
+  return G4UniformRand() < filmAbsorption;
 }
 
 
@@ -77,12 +135,9 @@ AbsorbAtElectrode(const G4Track& track, const G4Step& step,
            << G4endl;
   }
 
-  // Create KaplanQP simulator if not already available
-  if (!kaplanQP) {
-    G4MaterialPropertiesTable* ncTable =
-      const_cast<G4MaterialPropertiesTable*>(theSurfaceTable);
-    kaplanQP = new G4CMPKaplanQP(ncTable, verboseLevel);
-  }
+  // KaplanQP simulator is normally built with table; ensure it exists
+  if (!kaplanQP) kaplanQP = new G4CMPKaplanQP(theSurfaceTable, verboseLevel);
+  kaplanQP->SetVerboseLevel(verboseLevel);
 
   // Transfer phonon energy into superconducting film
   G4double Ekin = GetKineticEnergy(track);
@@ -122,28 +177,29 @@ ProcessAbsorption(const G4Track& track, const G4Step& step, G4double EDep,
   // Secondaries are emitted with cos(theta) distribution inward
   G4ThreeVector surfNorm = G4CMP::GetSurfaceNormal(step);
 
-  // Create secondaries for all of the generated phonon energies
-  particleChange.SetNumberOfSecondaries(phononEnergies.size());
-
+  // Choose modes and directions for all of the generated phonon energies
   G4double Ekin = GetKineticEnergy(track);
   G4ThreeVector k = GetLocalWaveVector(track);
 
+  phononModes.clear();
+  phononWaveVecs.clear();
+
   G4ThreeVector reflectedKDir;
   for (G4double E : phononEnergies) {
     G4double kmag = k.mag()*E/Ekin;	// Scale k vector by energy
     G4int pol = ChoosePhononPolarization();
-    do {
-      reflectedKDir = G4CMP::LambertReflection(surfNorm);
-    } while (!G4CMP::PhononVelocityIsInward(theLattice, pol,
-                                            kmag*reflectedKDir, surfNorm));
-
-    G4Track* phonon = G4CMP::CreatePhonon(GetCurrentTouchable(),
-					  pol, kmag*reflectedKDir,
-					  E, track.GetGlobalTime(),
-					  track.GetPosition());
-    particleChange.AddSecondary(phonon);
+    reflectedKDir = G4CMP::LambertReflection(theLattice, pol, surfNorm);
+
+    phononModes.push_back(pol);
+    phononWaveVecs.push_back(kmag*reflectedKDir);
   }	// for (E : ...)
 
+  // Create secondaries together and pass them all to tracking
+  G4CMP::CreatePhonons(track, phononModes, phononWaveVecs, phononEnergies,
+		       track.GetGlobalTime(), track.GetPosition(),
+		       phononTracks);
+  G4CMP::AddSecondaries(particleChange, phononTracks);
+
   // Sanity check: secondaries' energy should equal assigned E
   if (verboseLevel>1) {
     G4double Esum = 0.;
@@ -173,11 +229,8 @@ ProcessReflection(const G4Track& track, const G4Step& step,
 
   G4int pol = GetPolarization(track);
 
-  G4ThreeVector reflectedKDir;
-  do {
-    reflectedKDir = G4CMP::LambertReflection(surfNorm);
-  } while (!G4CMP::PhononVelocityIsInward(theLattice, pol,
-					  reflectedKDir, surfNorm));
+  G4ThreeVector reflectedKDir =
+    G4CMP::LambertReflection(theLattice, pol, surfNorm);
 
   if (verboseLevel>1)
     G4cout << " Phonon reflected from QET toward " << reflectedKDir << G4endl;
@@ -7,6 +7,8 @@
 /// \brief Compute rate for phonon impurity scattering (mode mixing)
 //
 // $Id$
+//
+// 20261018  Compute rate from G4CMPRateContext, not from track
 
 #include "G4CMPPhononScatteringRate.hh"
 #include "G4LatticePhysical.hh"
@@ -15,9 +17,9 @@
 
 // Scattering rate is computed from electric field
 
-G4double G4CMPPhononScatteringRate::Rate(const G4Track& aTrack) const {
-  G4double B = theLattice->GetScatteringConstant();
-  G4double Eoverh = GetKineticEnergy(aTrack)/h_Planck;
+G4double G4CMPPhononScatteringRate::Rate(const G4CMPRateContext& ctx) const {
+  G4double B = ctx.lattice->GetScatteringConstant();
+  G4double Eoverh = ctx.energy/h_Planck;
   
   return (Eoverh*Eoverh*Eoverh*Eoverh*B);
 }
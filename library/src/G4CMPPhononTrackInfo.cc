@@ -13,11 +13,10 @@
 //
 // 20161111 Initial commit - R. Agnese
 // 20170728 M. Kelsey -- Replace "k" function args with "theK" (-Wshadow)
+// 20261018  Allocate from per-thread G4CMPTrackInfoPool
 
 #include "G4CMPPhononTrackInfo.hh"
 
-//G4Allocator<G4CMPPhononTrackInfo> G4CMPPhononTrackInfoAllocator;
-
 G4CMPPhononTrackInfo::G4CMPPhononTrackInfo(const G4LatticePhysical* lat,
                                            G4ThreeVector theK)
   : G4CMPVTrackInfo(lat), waveVec(theK) {;}
@@ -19,6 +19,9 @@
 //		process instances for each beam/trap type.
 // 20210203  G4CMP-241: SecondaryProduction must be last PostStep process.
 // 20220331  G4CMP-293: Replace RegisterProcess() with local AddG4CMPProcess().
+// 20261018  Replace trapping and trap ionization processes with a single
+//		combined process, sampling one MFP from the summed rate.
+// 20261018  Same for phonon scattering and downconversion.
 
 #include "G4CMPPhysics.hh"
 #include "G4CMPConfigManager.hh"
@@ -26,8 +29,7 @@
 #include "G4CMPDriftElectron.hh"
 #include "G4CMPDriftHole.hh"
 #include "G4CMPDriftRecombinationProcess.hh"
-#include "G4CMPDriftTrappingProcess.hh"
-#include "G4CMPDriftTrapIonization.hh"
+#include "G4CMPDriftTrapAndIonization.hh"
 #include "G4CMPInterValleyScattering.hh"
 #include "G4CMPLukeScattering.hh"
 #include "G4CMPPhononBoundaryProcess.hh"
@@ -36,9 +38,8 @@
 #include "G4CMPTrackLimiter.hh"
 #include "G4GenericIon.hh"
 #include "G4ParticleTable.hh"
-#include "G4PhononDownconversion.hh"
 #include "G4PhononLong.hh"
-#include "G4PhononScattering.hh"
+#include "G4PhononScatteringAndDecay.hh"
 #include "G4PhononTransFast.hh"
 #include "G4PhononTransSlow.hh"
 #include "G4ProcessManager.hh"
@@ -66,44 +67,38 @@ void G4CMPPhysics::ConstructParticle() {
 
 void G4CMPPhysics::ConstructProcess() {
   // Only make processes once; will be deleted when physics list goes away
-  G4VProcess* phScat  = new G4PhononScattering;
   G4VProcess* phRefl  = new G4CMPPhononBoundaryProcess;
-  G4VProcess* phDown  = new G4PhononDownconversion;
   G4VProcess* tmStep  = new G4CMPTimeStepper;
   G4VProcess* driftB  = new G4CMPDriftBoundaryProcess;
   G4VProcess* ivScat  = new G4CMPInterValleyScattering;
   G4VProcess* luke    = new G4CMPLukeScattering(tmStep);
   G4VProcess* recomb  = new G4CMPDriftRecombinationProcess;
   G4VProcess* eLimit  = new G4CMPTrackLimiter;
-  G4VProcess* trapping = new G4CMPDriftTrappingProcess;
 
-  // NOTE: Trap ionization needs separate instances for each particle type
+  // NOTE: Phonon scattering and downconversion share one MFP draw
+  G4VProcess* phBulk  = new G4PhononScatteringAndDecay;
+
+  // NOTE: Trapping and trap ionization share one process and one MFP draw
+  G4VProcess* trapping = new G4CMPDriftTrapAndIonization;
+
   G4ParticleDefinition* edrift = G4CMPDriftElectron::Definition();
   G4ParticleDefinition* hdrift = G4CMPDriftHole::Definition();
 
-  G4VProcess* eeTrpI = new G4CMPDriftTrapIonization(edrift, edrift);
-  G4VProcess* ehTrpI = new G4CMPDriftTrapIonization(edrift, hdrift);
-  G4VProcess* heTrpI = new G4CMPDriftTrapIonization(hdrift, edrift);
-  G4VProcess* hhTrpI = new G4CMPDriftTrapIonization(hdrift, hdrift);
-
   // Add processes only to locally known particles
   G4ParticleDefinition* particle = 0;
 
   particle = G4PhononLong::PhononDefinition();
-  AddG4CMPProcess(phScat, particle);
-  AddG4CMPProcess(phDown, particle);
+  AddG4CMPProcess(phBulk, particle);
   AddG4CMPProcess(phRefl, particle);
   AddG4CMPProcess(eLimit, particle);
 
   particle = G4PhononTransSlow::PhononDefinition();
-  AddG4CMPProcess(phScat, particle);
-  AddG4CMPProcess(phDown, particle);
+  AddG4CMPProcess(phBulk, particle);
   AddG4CMPProcess(phRefl, particle);
   AddG4CMPProcess(eLimit, particle);
 
   particle = G4PhononTransFast::PhononDefinition();
-  AddG4CMPProcess(phScat, particle);
-  AddG4CMPProcess(phDown, particle);
+  AddG4CMPProcess(phBulk, particle);
   AddG4CMPProcess(phRefl, particle);
   AddG4CMPProcess(eLimit, particle);
 
@@ -114,9 +109,7 @@ void G4CMPPhysics::ConstructProcess() {
   AddG4CMPProcess(driftB, particle);
   AddG4CMPProcess(recomb, particle);
   AddG4CMPProcess(eLimit, particle);
-  AddG4CMPProcess(trapping, particle);
-  AddG4CMPProcess(eeTrpI, particle);	// e- projectile on both traps
-  AddG4CMPProcess(ehTrpI, particle);
+  AddG4CMPProcess(trapping, particle);	// Includes ionization of both traps
 
   particle = hdrift;
   AddG4CMPProcess(tmStep, particle);
@@ -124,9 +117,7 @@ void G4CMPPhysics::ConstructProcess() {
   AddG4CMPProcess(driftB, particle);
   AddG4CMPProcess(recomb, particle);
   AddG4CMPProcess(eLimit, particle);
-  AddG4CMPProcess(trapping, particle);
-  AddG4CMPProcess(heTrpI, particle);	// h+ projectile on both traps
-  AddG4CMPProcess(hhTrpI, particle);
+  AddG4CMPProcess(trapping, particle);	// Includes ionization of both traps
 
   AddSecondaryProduction();
 }
@@ -39,19 +39,25 @@
 // 20201124  Change argument name in MakeGlobalRecoil() to 'krecoil' (track)
 // 20201223  Add FindNearestValley() function to align electron momentum.
 // 20210318  In LoadDataForTrack, kill a bad track, not the whole event.
+// 20261018  Add MakeRateContext() to collect kinematics for rate models.
+// 20261018  ChargeCarrierTimeStep() calls G4CMP:: function; fill only
+//	    requested G4CMPRateContext contents.
 
 #include "G4CMPProcessUtils.hh"
 #include "G4CMPDriftElectron.hh"
 #include "G4CMPDriftHole.hh"
 #include "G4CMPDriftTrackInfo.hh"
+#include "G4CMPFieldUtils.hh"
 #include "G4CMPGeometryUtils.hh"
 #include "G4CMPPhononTrackInfo.hh"
 #include "G4CMPUtils.hh"
 #include "G4CMPTrackUtils.hh"
 #include "G4AffineTransform.hh"
 #include "G4DynamicParticle.hh"
+#include "G4FieldManager.hh"
 #include "G4LatticeManager.hh"
 #include "G4LatticePhysical.hh"
+#include "G4LogicalVolume.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4ParallelWorldProcess.hh"
 #include "G4PhononLong.hh"
@@ -64,6 +70,7 @@
 #include "G4ThreeVector.hh"
 #include "G4Track.hh"
 #include "G4RandomDirection.hh"
+#include "G4VPhysicalVolume.hh"
 #include "G4VTouchable.hh"
 #include "Randomize.hh"
 #include "G4GeometryTolerance.hh"
@@ -493,8 +500,50 @@ G4int G4CMPProcessUtils::FindNearestValley(G4ThreeVector dir) const {
 
 G4double 
 G4CMPProcessUtils::ChargeCarrierTimeStep(G4double mach, G4double l0) const {
-  const G4double velLong = theLattice->GetSoundSpeed();
+  return G4CMP::ChargeCarrierTimeStep(theLattice, mach, l0);
+}
+
+
+// Collect kinematics of track for scattering rate calculations
+// Only requested contents are computed; electron band-structure mappings
+// and field lookups are the expensive ones
+
+G4CMPRateContext
+G4CMPProcessUtils::MakeRateContext(const G4Track& track, G4int needs) const {
+  G4CMPRateContext ctx;
+  ctx.lattice = theLattice;
+  ctx.particle = track.GetParticleDefinition();
+  ctx.contents = needs;
+
+  if (G4CMP::IsElectron(track)) {
+    ctx.valley = GetValleyIndex(track);
+    ctx.vLocal = GetLocalVelocityVector(track);
+    if (needs & G4CMPRateContext::Energy)
+      ctx.energy = theLattice->MapV_elToEkin(ctx.valley, ctx.vLocal);
+    if (needs & G4CMPRateContext::WaveVector)
+      ctx.kLocal = theLattice->MapV_elToP(ctx.valley, ctx.vLocal) / hbarc;
+    if (needs & G4CMPRateContext::HVWaveVector)
+      ctx.kHV = theLattice->MapV_elToK_HV(ctx.valley, ctx.vLocal);
+  } else if (G4CMP::IsHole(track)) {
+    ctx.vLocal = GetLocalVelocityVector(track);
+    ctx.energy = track.GetKineticEnergy();
+    if (needs & (G4CMPRateContext::WaveVector|G4CMPRateContext::HVWaveVector))
+      ctx.kLocal = GetLocalDirection(track.GetMomentum()) / hbarc;
+    ctx.kHV = ctx.kLocal;
+  } else if (G4CMP::IsPhonon(track)) {
+    ctx.energy = track.GetKineticEnergy();
+    if (needs & G4CMPRateContext::WaveVector)
+      ctx.kLocal = GetLocalWaveVector(track);
+  }
+
+  if ((needs & G4CMPRateContext::Field) && G4CMP::IsChargeCarrier(track)) {
+    const G4FieldManager* fMan =
+      track.GetVolume()->GetLogicalVolume()->GetFieldManager();
+
+    ctx.hasField = (fMan && fMan->DoesFieldExist());
+    if (ctx.hasField)
+      ctx.field = GetLocalDirection(G4CMP::GetFieldAtPosition(track));
+  }
 
-  const G4double tstep = 3.*l0/velLong;
-  return (mach<1.) ? tstep : tstep*mach/((mach-1)*(mach-1)*(mach-1));
+  return ctx;
 }
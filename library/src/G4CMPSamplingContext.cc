@@ -0,0 +1,44 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/src/G4CMPSamplingContext.cc
+/// \brief Implementation of the G4CMPSamplingContext class, carrying the
+///	   downsampling factors for the current energy partition.
+//
+// 20261018  New class for per-partition sampling, leaving config unchanged
+
+#include "G4CMPSamplingContext.hh"
+#include "G4CMPConfigManager.hh"
+
+
+// Per-thread instance, reset if user has changed configuration
+
+G4CMPSamplingContext& G4CMPSamplingContext::Current() {
+  static G4ThreadLocal G4CMPSamplingContext* theContext = 0;
+
+  if (!theContext) theContext = new G4CMPSamplingContext;
+  else if (theContext->ConfigChanged()) theContext->Reset();
+
+  return *theContext;
+}
+
+
+// Constructor starts with user's settings
+
+G4CMPSamplingContext::G4CMPSamplingContext() {
+  Reset();
+}
+
+void G4CMPSamplingContext::Reset() {
+  genPhonons = userPhonons = G4CMPConfigManager::GetGenPhonons();
+  genCharges = userCharges = G4CMPConfigManager::GetGenCharges();
+  lukeSample = userLuke    = G4CMPConfigManager::GetLukeSampling();
+}
+
+G4bool G4CMPSamplingContext::ConfigChanged() const {
+  return (userPhonons != G4CMPConfigManager::GetGenPhonons() ||
+	  userCharges != G4CMPConfigManager::GetGenCharges() ||
+	  userLuke    != G4CMPConfigManager::GetLukeSampling());
+}
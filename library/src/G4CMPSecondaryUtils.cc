@@ -13,12 +13,14 @@
 // 20210518 M. Kelsey -- Protect new secondaries from production cuts
 // 20220907 G4CMP-316 -- Pass track into CreateXYZ() functions; do valley
 //		selection for electrons in CreateChargeCarrier().
+// 20261018  Add CreatePhonons() and AddSecondaries() for batches.
 
 #include "G4CMPSecondaryUtils.hh"
 #include "G4CMPDriftHole.hh"
 #include "G4CMPDriftElectron.hh"
 #include "G4CMPDriftTrackInfo.hh"
 #include "G4CMPGeometryUtils.hh"
+#include "G4CMPGlobalLocalTransformStore.hh"
 #include "G4CMPPhononTrackInfo.hh"
 #include "G4CMPTrackUtils.hh"
 #include "G4CMPUtils.hh"
@@ -31,6 +33,7 @@
 #include "G4SystemOfUnits.hh"
 #include "G4Threading.hh"
 #include "G4Track.hh"
+#include "G4VParticleChange.hh"
 #include "G4VPhysicalVolume.hh"
 #include "G4VTouchable.hh"
 
@@ -93,6 +96,73 @@ G4Track* G4CMP::CreatePhonon(const G4Track& track, G4int mode,
   return sec;
 }
 
+// Batch of phonons at common position and time; track info is given the
+// lattice directly, so the new tracks' volumes need not be located
+
+void G4CMP::CreatePhonons(const G4Track& track,
+			  const std::vector<G4int>& modes,
+			  const std::vector<G4ThreeVector>& waveVecs,
+			  const std::vector<G4double>& energies,
+			  G4double time, const G4ThreeVector& pos,
+			  std::vector<G4Track*>& secondaries) {
+  if (modes.size() != energies.size() || waveVecs.size() != energies.size()) {
+    G4Exception("G4CMP::CreatePhonons", "Secondary011", EventMustBeAborted,
+		"Mode, wavevector and energy lists have different lengths.");
+    return;
+  }
+
+  G4LatticePhysical* lat = G4CMP::GetLattice(track);
+  if (!lat) {
+    G4Exception("G4CMP::CreatePhonons", "Secondary002", EventMustBeAborted,
+                ("No lattice for volume "+track.GetVolume()->GetName()).c_str());
+    return;
+  }
+
+  const G4VTouchable* touch = track.GetTouchable();
+  const G4AffineTransform& toGlobal =
+    G4CMPGlobalLocalTransformStore::ToGlobal(touch);
+  G4ThreeVector secPos = G4CMP::ApplySurfaceClearance(touch, pos);
+
+  secondaries.reserve(secondaries.size() + energies.size());
+  for (size_t i=0; i<energies.size(); i++) {
+    G4int mode = modes[i];
+    if (mode == G4PhononPolarization::UNKNOWN) {	// Choose value
+      mode = ChoosePhononPolarization(lat);
+    }
+
+    const G4ThreeVector& waveVec = waveVecs[i];
+    G4ThreeVector vgroup = lat->MapKtoVDir(mode, waveVec);
+    toGlobal.ApplyAxisTransform(vgroup);
+
+    G4ParticleDefinition* thePhonon = G4PhononPolarization::Get(mode);
+    auto sec = new G4Track(new G4DynamicParticle(thePhonon, vgroup, energies[i]),
+			   time, secPos);
+    sec->SetGoodForTrackingFlag(true);	// Protect against production cuts
+
+    // Store wavevector in auxiliary info for track
+    AttachTrackInfo(sec, new G4CMPPhononTrackInfo(lat,
+						  toGlobal.TransformAxis(waveVec)));
+
+    sec->SetVelocity(lat->MapKtoV(mode, waveVec));
+    sec->UseGivenVelocity(true);
+
+    secondaries.push_back(sec);
+  }
+}
+
+// Particle change is sized once for the whole batch, unless other
+// secondaries were already added
+
+void G4CMP::AddSecondaries(G4VParticleChange& particleChange,
+			   std::vector<G4Track*>& secondaries) {
+  if (particleChange.GetNumberOfSecondaries() == 0)
+    particleChange.SetNumberOfSecondaries(secondaries.size());
+
+  for (G4Track* sec: secondaries) particleChange.AddSecondary(sec);
+  secondaries.clear();
+}
+
+
 // DEPRECATED: Version used by application code with output of G4CMPKaplanQP
 
 G4Track* G4CMP::CreatePhonon(const G4VTouchable* touch, G4int mode,
@@ -0,0 +1,181 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/src/G4CMPSpecularTable.cc
+/// \brief Implementation of the G4CMPSpecularTable class, for correcting
+///	   specular phonon reflection to have inward group velocity.
+//
+// 20261018  New class for tabulated specular reflection correction
+
+#include "G4CMPSpecularTable.hh"
+#include "G4CMPConfigManager.hh"
+#include "G4CMPSurfaceTableCache.hh"
+#include "G4LatticePhysical.hh"
+#include "G4PhysicalConstants.hh"
+#include <algorithm>
+#include <cmath>
+
+
+// Grid granularity; most nodes need no correction, costing one lookup
+
+const G4int G4CMPSpecularTable::nS = 24;
+const G4int G4CMPSpecularTable::nPhi = 48;
+const G4int G4CMPSpecularTable::nScan = 32;
+const G4double G4CMPSpecularTable::maxCorrection = 2.;
+
+
+// Per-thread cache of tables, keyed by lattice, mode and rounded normal
+
+const G4CMPSpecularTable*
+G4CMPSpecularTable::GetTable(const G4LatticePhysical* lat, G4int mode,
+			     const G4ThreeVector& surfNorm) {
+  return G4CMPSurfaceTableCache<G4CMPSpecularTable>::GetTable(lat, mode,
+							      surfNorm);
+}
+
+
+// Constructor
+
+G4CMPSpecularTable::G4CMPSpecularTable(const G4LatticePhysical* lat,
+				       G4int theMode,
+				       const G4ThreeVector& surfNorm)
+  : lattice(lat), mode(theMode), nValid(0) {
+  FillTable(surfNorm);
+
+  if (G4CMPConfigManager::GetVerboseLevel() > 1) {
+    G4cout << "G4CMPSpecularTable mode " << mode << " normal " << surfNorm
+	   << " " << nValid << " of " << correction.size() << " nodes"
+	   << G4endl;
+  }
+}
+
+
+// Find correction at each grid node, from s = 0 to 1 inclusive
+
+void G4CMPSpecularTable::FillTable(const G4ThreeVector& surfNorm) {
+  G4ThreeVector e1 = surfNorm.orthogonal().unit();
+  G4ThreeVector e2 = surfNorm.cross(e1);
+
+  correction.assign((nS+1)*nPhi, -1.);
+  nValid = 0;
+
+  for (G4int is=0; is<=nS; is++) {
+    G4double sinTheta = std::sqrt(G4double(is)/nS);
+    G4double cosTheta = std::sqrt(1.-G4double(is)/nS);
+
+    for (G4int iphi=0; iphi<nPhi; iphi++) {
+      G4double phi = twopi*iphi/nPhi;
+      G4ThreeVector kdir = (-cosTheta*surfNorm
+			    + sinTheta*(std::cos(phi)*e1 + std::sin(phi)*e2));
+
+      G4double c = FindCorrection(kdir, surfNorm);
+      correction[is*nPhi+iphi] = c;
+      if (c >= 0.) nValid++;
+    }
+  }
+}
+
+
+// Scan for first inward direction, then bisect to the sign change
+
+G4double G4CMPSpecularTable::FindCorrection(const G4ThreeVector& kdir,
+					    const G4ThreeVector& surfNorm) const {
+  if (NormalVelocity(kdir, surfNorm) < 0.) return 0.;
+
+  G4double lo = 0., hi = -1.;
+  for (G4int i=1; i<=nScan; i++) {
+    G4double c = maxCorrection*i/nScan;
+    if (NormalVelocity(kdir, surfNorm, c) < 0.) { hi = c; break; }
+    lo = c;
+  }
+
+  if (hi < 0.) return -1.;		// No inward direction in range
+
+  for (G4int i=0; i<30; i++) {
+    G4double mid = 0.5*(lo+hi);
+    if (NormalVelocity(kdir, surfNorm, mid) < 0.) hi = mid;
+    else lo = mid;
+  }
+
+  return hi;
+}
+
+
+// Bilinear interpolation in (s,phi); all four nodes must have a value
+
+G4double G4CMPSpecularTable::Interpolate(const G4ThreeVector& kdir,
+					 const G4ThreeVector& surfNorm) const {
+  G4double cosTheta = -kdir.dot(surfNorm);
+  if (cosTheta <= 0.) return -1.;	// Not a reflected direction
+
+  G4ThreeVector e1 = surfNorm.orthogonal().unit();
+  G4ThreeVector e2 = surfNorm.cross(e1);
+
+  G4double phi = std::atan2(kdir.dot(e2), kdir.dot(e1));
+  if (phi < 0.) phi += twopi;
+
+  G4double u = std::max(0., 1.-cosTheta*cosTheta) * nS;
+  G4int is = std::min(G4int(u), nS-1);
+  G4double fs = u - is;
+
+  G4double w = phi/twopi * nPhi;
+  G4int iphi = G4int(w);
+  G4double fp = w - iphi;
+  iphi %= nPhi;
+  G4int jphi = (iphi+1) % nPhi;
+
+  G4double c00 = correction[is*nPhi+iphi];
+  G4double c01 = correction[is*nPhi+jphi];
+  G4double c10 = correction[(is+1)*nPhi+iphi];
+  G4double c11 = correction[(is+1)*nPhi+jphi];
+  if (c00 < 0. || c01 < 0. || c10 < 0. || c11 < 0.) return -1.;
+
+  return ((1.-fs)*((1.-fp)*c00 + fp*c01) + fs*((1.-fp)*c10 + fp*c11));
+}
+
+
+// Start from table, take one Newton step to zero normal velocity, then
+// step just past the zero to make the velocity inward
+
+G4bool G4CMPSpecularTable::Correct(G4ThreeVector& kdir,
+				   const G4ThreeVector& surfNorm) const {
+  G4ThreeVector k = kdir.unit();
+  G4double c = Interpolate(k, surfNorm);
+  if (c < 0.) return false;
+
+  G4double f = NormalVelocity(k, surfNorm, c);
+  if (f >= 0.) {
+    const G4double dc = 1e-4;
+    G4double fprime = (NormalVelocity(k, surfNorm, c+dc) - f) / dc;
+    if (!(fprime < 0.)) return false;	// Not approaching the sign change
+
+    c = std::min(c - f/fprime, maxCorrection);
+
+    G4double step = 1e-6;
+    for (G4int i=0; i<10 && (f = NormalVelocity(k, surfNorm, c)) >= 0.; i++) {
+      c += step;
+      step *= 4.;
+    }
+
+    if (f >= 0.) return false;
+  }
+
+  kdir = (k - c*surfNorm).unit();
+  return true;
+}
+
+
+// Same test as G4CMP::PhononVelocityIsInward()
+
+G4double G4CMPSpecularTable::NormalVelocity(const G4ThreeVector& kdir,
+					    const G4ThreeVector& surfNorm) const {
+  return lattice->MapKtoVDir(mode, kdir).dot(surfNorm);
+}
+
+G4double G4CMPSpecularTable::NormalVelocity(const G4ThreeVector& kdir,
+					    const G4ThreeVector& surfNorm,
+					    G4double c) const {
+  return NormalVelocity((kdir - c*surfNorm).unit(), surfNorm);
+}
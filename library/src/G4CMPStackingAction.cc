@@ -20,6 +20,8 @@
 // 20170620 Drop obsolete SetTransforms() call
 // 20170624 Clean up track initialization
 // 20170928 Replace "polarization" with "mode"
+// 20261018 Add queue of primaries delivered in chunks at each new stage
+// 20261018 Queue per-vertex counts; draw tracks as each chunk is pushed
 
 #include "G4CMPStackingAction.hh"
 
@@ -29,6 +31,9 @@
 #include "G4CMPPhononTrackInfo.hh"
 #include "G4CMPTrackUtils.hh"
 #include "G4CMPUtils.hh"
+#include "G4DynamicParticle.hh"
+#include "G4Event.hh"
+#include "G4EventManager.hh"
 #include "G4LatticeManager.hh"
 #include "G4LatticePhysical.hh"
 #include "G4PhononLong.hh"
@@ -42,14 +47,17 @@
 #include "G4ThreeVector.hh"
 #include "G4Track.hh"
 #include "G4TrackStatus.hh"
+#include "G4TrackVector.hh"
 #include "G4VPhysicalVolume.hh"
 #include "Randomize.hh"
+#include <algorithm>
 
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
 G4CMPStackingAction::G4CMPStackingAction()
-  : G4UserStackingAction(), G4CMPProcessUtils() {;}
+  : G4UserStackingAction(), G4CMPProcessUtils(), nextQueued(0), nQueued(0),
+    chunkSize(10000), queueEventID(-1), holdingTrack(false) {;}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
@@ -86,9 +94,112 @@ G4CMPStackingAction::ClassifyNewTrack(const G4Track* aTrack) {
 
   ReleaseTrack();
 
+  // Hold back one track so that NewStage() is called to push next chunk
+  if (!holdingTrack && nQueued > 0) {
+    classification = fWaiting;
+    holdingTrack = true;
+  }
+
   return classification; 
 }
 
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+// Urgent stack is empty, and held track has been moved there
+
+void G4CMPStackingAction::NewStage() {
+  holdingTrack = false;
+  PushQueuedTracks();
+}
+
+// Primaries are generated before this call, so keep current event's queue
+
+void G4CMPStackingAction::PrepareNewEvent() {
+  holdingTrack = false;
+
+  const G4Event* event =
+    G4EventManager::GetEventManager()->GetConstCurrentEvent();
+  if (!event || event->GetEventID() != queueEventID) ClearQueue();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+void G4CMPStackingAction::SetQueueEvent(const G4Event* event) {
+  G4int eventID = event ? event->GetEventID() : -1;
+  if (eventID != queueEventID) ClearQueue();
+  queueEventID = eventID;
+}
+
+void G4CMPStackingAction::QueueVertex(const QueuedVertex& vtx) {
+  if (vtx.Count() == 0) return;
+
+  queue.push_back(vtx);
+  nQueued += vtx.Count();
+}
+
+void G4CMPStackingAction::ClearQueue() {
+  queue.clear();
+  nextQueued = nQueued = 0;
+  queueEventID = -1;
+}
+
+// Create tracks for next chunk; event manager assigns track IDs
+
+void G4CMPStackingAction::PushQueuedTracks() {
+  if (nQueued == 0) return;
+
+  size_t nPush = std::min(chunkSize, nQueued);
+  if (nPush == 0) nPush = 1;			// Avoid stalling on zero
+
+  G4TrackVector tracks;
+  tracks.reserve(nPush);
+
+  while (tracks.size() < nPush && nextQueued < queue.size()) {
+    QueuedVertex& vtx = queue[nextQueued];
+    if (vtx.Count() == 0) nextQueued++;
+    else tracks.push_back(CreateQueuedTrack(vtx));
+  }
+
+  nQueued -= tracks.size();
+  if (nQueued == 0) {				// Last chunk; keep capacity
+    queue.clear();
+    nextQueued = 0;
+  }
+
+  G4EventManager::GetEventManager()->StackTracks(&tracks);
+}
+
+// Choose type in proportion to those remaining at vertex, equivalent to
+// taking the next entry of a shuffled list
+
+G4Track* G4CMPStackingAction::CreateQueuedTrack(QueuedVertex& vtx) const {
+  const G4ParticleDefinition* pd = 0;
+  G4double ekin = 0., wt = 0.;
+
+  size_t pick = G4CMP::RandomIndex(vtx.Count());
+  if (pick < vtx.nElec) {
+    pd = G4CMPDriftElectron::Definition();
+    ekin = vtx.eElec; wt = vtx.chargeWt;
+    vtx.nElec--;
+  } else if (pick < vtx.nElec+vtx.nHole) {
+    pd = G4CMPDriftHole::Definition();
+    ekin = vtx.eHole; wt = vtx.chargeWt;
+    vtx.nHole--;
+  } else {
+    pd = G4PhononPolarization::Get(G4CMP::ChoosePhononPolarization(vtx.lattice));
+    ekin = vtx.ePhon; wt = vtx.phononWt;
+    vtx.nPhon--;
+  }
+
+  G4Track* theTrack =
+    new G4Track(new G4DynamicParticle(pd, G4RandomDirection(), ekin),
+		vtx.time, vtx.pos);
+  theTrack->SetWeight(wt);
+  theTrack->SetParentID(0);			// Treat as primary track
+
+  return theTrack;
+}
+
 // Set velocity of phonon track appropriately for material
 
 void G4CMPStackingAction::SetPhononVelocity(const G4Track* aTrack) const {
@@ -0,0 +1,51 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/src/G4CMPSurfaceData.cc
+/// \brief Implementation of the G4CMPSurfaceData container, for lookup
+///	   of tabulated phonon reflection probabilities.
+//
+// 20261018  New container for compiled surface properties
+// 20261018  Reject lookup if probabilities were not filled (no specProb)
+// 20261018  Use distinct exception code for missing reflection table
+
+#include "G4CMPSurfaceData.hh"
+#include <algorithm>
+
+
+// Find segment containing frequency, and interpolate between nodes
+
+void G4CMPSurfaceData::GetReflectionProbs(G4double freq, G4double& anhProb,
+					  G4double& specProb,
+					  G4double& diffProb) const {
+  if (!hasReflection) {
+    G4Exception("G4CMPSurfaceData::GetReflectionProbs", "detector005",
+		FatalException, "Phonon surface properties have no specProb;"
+		" cannot choose reflection type.");
+  }
+
+  G4double probs[kNChannels];
+  std::copy(reflTail, reflTail+kNChannels, probs);
+
+  size_t nseg = reflEdge.empty() ? 0 : reflEdge.size()-1;
+  size_t iseg = 0;
+  while (iseg < nseg && freq > reflEdge[iseg+1]) iseg++;
+
+  if (iseg < nseg) {
+    G4double lo = reflEdge[iseg], hi = reflEdge[iseg+1];
+    G4double u = (freq > lo) ? (freq-lo)/(hi-lo) * (reflNodes-1) : 0.;
+    G4int inode = std::min(G4int(u), reflNodes-2);
+    G4double f = u - inode;
+
+    const G4double* node = &reflTable[(iseg*reflNodes+inode)*kNChannels];
+    for (G4int i=0; i<kNChannels; i++) {
+      probs[i] = node[i] + f*(node[kNChannels+i] - node[i]);
+    }
+  }
+
+  anhProb  = probs[kAnharmonic];
+  specProb = probs[kSpecular];
+  diffProb = probs[kDiffuse];
+}
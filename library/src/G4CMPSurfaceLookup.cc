@@ -0,0 +1,166 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/src/G4CMPSurfaceLookup.cc
+/// \brief Implementation of the G4CMPSurfaceLookup class, a shared hash
+///	   table of G4CMP border and skin surfaces.
+//
+// 20261018  New shared lookup table for boundary surfaces
+// 20261018  Refresh surface data from master, not from first worker
+
+#include "G4CMPSurfaceLookup.hh"
+#include "G4CMPConfigManager.hh"
+#include "G4CMPLogicalBorderSurface.hh"
+#include "G4CMPLogicalSkinSurface.hh"
+#include "G4CMPSurfaceProperty.hh"
+#include "G4AutoLock.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Threading.hh"
+#include "G4VPhysicalVolume.hh"
+#include <stdint.h>
+
+
+namespace {
+  G4Mutex lookupMutex = G4MUTEX_INITIALIZER;	// For thread protection
+}
+
+// Shared singleton -- filled once, then read-only
+
+std::atomic<G4CMPSurfaceLookup*> G4CMPSurfaceLookup::theTable(nullptr);
+
+const G4CMPSurfaceLookup* G4CMPSurfaceLookup::GetInstance() {
+  G4CMPSurfaceLookup* table = theTable.load(std::memory_order_acquire);
+  if (table) return table;
+
+  G4AutoLock l(&lookupMutex);		// Only one thread fills the table
+  table = theTable.load(std::memory_order_relaxed);
+  if (!table) {
+    table = new G4CMPSurfaceLookup;
+    theTable.store(table, std::memory_order_release);
+  }
+
+  return table;
+}
+
+void G4CMPSurfaceLookup::Invalidate() {
+  G4AutoLock l(&lookupMutex);
+  delete theTable.exchange(nullptr);
+}
+
+
+// Tables may have been edited through pointers since last update; workers
+// only read surface data, so it is refreshed before they start tracking
+
+void G4CMPSurfaceLookup::UpdateSurfaceData() {
+  if (!G4Threading::IsMasterThread()) return;
+
+  if (G4CMPLogicalBorderSurface::GetNumberOfSurfaces() > 0) {
+    for (const auto& border: *G4CMPLogicalBorderSurface::GetSurfaceTable()) {
+      G4CMPSurfaceProperty* surfProp =
+	dynamic_cast<G4CMPSurfaceProperty*>(border.second->GetSurfaceProperty());
+      if (surfProp) surfProp->UpdateSurfaceData();
+    }
+  }
+
+  if (G4CMPLogicalSkinSurface::GetNumberOfSurfaces() > 0) {
+    for (const auto& skin: *G4CMPLogicalSkinSurface::GetSurfaceTable()) {
+      G4CMPSurfaceProperty* surfProp =
+	dynamic_cast<G4CMPSurfaceProperty*>(skin.second->GetSurfaceProperty());
+      if (surfProp) surfProp->UpdateSurfaceData();
+    }
+  }
+}
+
+
+// Constructor
+
+G4CMPSurfaceLookup::G4CMPSurfaceLookup() : mask(0), nEntries(0) {
+  Fill();
+
+  if (G4CMPConfigManager::GetVerboseLevel() > 1) {
+    G4cout << "G4CMPSurfaceLookup " << nEntries << " surfaces in "
+	   << slots.size() << " slots" << G4endl;
+  }
+}
+
+
+// Copy both registries into table, keeping load factor at most 1/2
+
+void G4CMPSurfaceLookup::Fill() {
+  size_t nBorder = G4CMPLogicalBorderSurface::GetNumberOfSurfaces();
+  size_t nSkin = G4CMPLogicalSkinSurface::GetNumberOfSurfaces();
+
+  size_t nslot = 16;
+  while (nslot < 2*(nBorder+nSkin)) nslot *= 2;
+
+  slots.assign(nslot, Entry());
+  mask = nslot-1;
+  nEntries = 0;
+
+  if (nBorder > 0) {
+    for (const auto& border: *G4CMPLogicalBorderSurface::GetSurfaceTable()) {
+      Insert(border.first.first, border.first.second, border.second);
+    }
+  }
+
+  if (nSkin > 0) {
+    for (const auto& skin: *G4CMPLogicalSkinSurface::GetSurfaceTable()) {
+      Insert(skin.first, 0, skin.second);
+    }
+  }
+}
+
+void G4CMPSurfaceLookup::Insert(const void* key1, const void* key2,
+				G4LogicalSurface* surface) {
+  if (!key1 || !surface) return;
+
+  size_t i = Hash(key1, key2);
+  while (slots[i].key1 && !(slots[i].key1 == key1 && slots[i].key2 == key2)) {
+    i = (i+1) & mask;
+  }
+
+  if (!slots[i].key1) nEntries++;
+
+  Entry& entry = slots[i];
+  entry.key1 = key1;
+  entry.key2 = key2;
+  entry.surface = surface;
+  entry.surfProp =
+    dynamic_cast<G4CMPSurfaceProperty*>(surface->GetSurfaceProperty());
+}
+
+
+// Border surface first, then skin surface of first volume
+
+const G4CMPSurfaceLookup::Entry*
+G4CMPSurfaceLookup::Find(const G4VPhysicalVolume* vol1,
+			 const G4VPhysicalVolume* vol2) const {
+  if (!vol1) return 0;
+
+  const Entry* entry = FindKey(vol1, vol2);
+  if (!entry) entry = FindKey(vol1->GetLogicalVolume(), 0);
+
+  return entry;
+}
+
+const G4CMPSurfaceLookup::Entry*
+G4CMPSurfaceLookup::FindKey(const void* key1, const void* key2) const {
+  if (!key1) return 0;
+
+  for (size_t i=Hash(key1, key2); slots[i].key1; i=(i+1)&mask) {
+    if (slots[i].key1 == key1 && slots[i].key2 == key2) return &slots[i];
+  }
+
+  return 0;
+}
+
+
+// Multiplicative hash of pointer pair; low bits of pointers are aligned
+
+size_t G4CMPSurfaceLookup::Hash(const void* key1, const void* key2) const {
+  uint64_t h = (uint64_t(uintptr_t(key1)) * 0x9E3779B97F4A7C15ULL
+		^ uint64_t(uintptr_t(key2)) * 0xC2B2AE3D27D4EB4FULL);
+  return size_t(h ^ (h >> 29)) & mask;
+}
@@ -12,6 +12,9 @@
 //		probabilities, and computation functions.
 // 20200601  G4CMP-206: Need thread-local copies of electrode pointers
 // 20220824  R. Cormier -- Default to scalar probs if no polynomials
+// 20261018  Fill G4CMPSurfaceData whenever tables or parameters change
+// 20261018  Missing specProb is an error at reflection, not all-diffuse
+// 20261018  Notify electrodes (and worker copies) when data is refilled
 
 #include "G4CMPSurfaceProperty.hh"
 #include "G4CMPVElectrodePattern.hh"
@@ -19,6 +22,8 @@
 #include "G4Threading.hh"
 #include "G4SystemOfUnits.hh"
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <functional>
 #include <stdexcept>	      // std::out_of_range
 #include <vector>
@@ -26,6 +31,7 @@
 
 namespace {
   G4Mutex elMutex = G4MUTEX_INITIALIZER;     // For thread protection
+  const G4int nReflNodes = 512;		     // Per segment of frequency table
 }
 
 // Constructors and destructor
@@ -33,7 +39,9 @@ namespace {
 G4CMPSurfaceProperty::G4CMPSurfaceProperty(const G4String& name,
                                            G4SurfaceType stype)
   : G4SurfaceProperty(name, stype), theChargeElectrode(0),
-    thePhononElectrode(0), anharmonicMaxFreq(0.), diffuseMaxFreq(0.) {;}
+    thePhononElectrode(0), anharmonicMaxFreq(0.), diffuseMaxFreq(0.) {
+  UpdateSurfaceData();
+}
 
 G4CMPSurfaceProperty::G4CMPSurfaceProperty(const G4String& name,
                                            G4double qAbsProb,
@@ -93,6 +101,7 @@ void G4CMPSurfaceProperty::SetChargeMaterialPropertiesTable(
                             G4MaterialPropertiesTable* mpt) {
   if (IsValidChargePropTable(*mpt)) {
     theChargeMatPropTable = *mpt;
+    UpdateSurfaceData();
   } else {
     G4Exception("G4CMPSurfaceProperty::SetChargeMaterialPropertiesTable",
                 "detector001", RunMustBeAborted,
@@ -104,6 +113,7 @@ void G4CMPSurfaceProperty::SetPhononMaterialPropertiesTable(
                             G4MaterialPropertiesTable* mpt) {
   if (IsValidChargePropTable(*mpt)) {
     thePhononMatPropTable = *mpt;
+    UpdateSurfaceData();
   } else {
     G4Exception("G4CMPSurfaceProperty::SetPhononMaterialPropertiesTable",
                 "detector002", RunMustBeAborted,
@@ -115,6 +125,7 @@ void G4CMPSurfaceProperty::SetChargeMaterialPropertiesTable(
   G4MaterialPropertiesTable& mpt) {
   if (IsValidChargePropTable(mpt)) {
     theChargeMatPropTable = mpt;
+    UpdateSurfaceData();
   } else {
     G4Exception("G4CMPSurfaceProperty::SetChargeMaterialPropertiesTable",
                 "detector003", RunMustBeAborted,
@@ -126,6 +137,7 @@ void G4CMPSurfaceProperty::SetPhononMaterialPropertiesTable(
   G4MaterialPropertiesTable& mpt) {
   if (IsValidChargePropTable(mpt)) {
     thePhononMatPropTable = mpt;
+    UpdateSurfaceData();
   } else {
     G4Exception("G4CMPSurfaceProperty::SetPhononMaterialPropertiesTable",
                 "detector004", RunMustBeAborted,
@@ -141,6 +153,7 @@ void G4CMPSurfaceProperty::FillChargeMaterialPropertiesTable(G4double qAbsProb,
   theChargeMatPropTable.AddConstProperty("reflProb", qReflProb);
   theChargeMatPropTable.AddConstProperty("minKElec", eMinK);
   theChargeMatPropTable.AddConstProperty("minKHole", hMinK);
+  UpdateSurfaceData();
 }
 
 void G4CMPSurfaceProperty::FillPhononMaterialPropertiesTable(G4double pAbsProb,
@@ -151,6 +164,93 @@ void G4CMPSurfaceProperty::FillPhononMaterialPropertiesTable(G4double pAbsProb,
   thePhononMatPropTable.AddConstProperty("reflProb", pReflProb);
   thePhononMatPropTable.AddConstProperty("specProb", pSpecProb);
   thePhononMatPropTable.AddConstProperty("absMinK", pMinK);
+  UpdateSurfaceData();
+}
+
+
+// Copy table values to typed fields, so boundary processes need no lookups
+
+void G4CMPSurfaceProperty::UpdateSurfaceData() {
+  FillSurfaceData(theChargeMatPropTable, theChargeData);
+  FillSurfaceData(thePhononMatPropTable, thePhononData);
+  FillReflectionTable(thePhononData);
+
+  // Electrodes may have cached values from the previous tables
+  if (theChargeElectrode) theChargeElectrode->SurfaceTableUpdated();
+  if (thePhononElectrode) thePhononElectrode->SurfaceTableUpdated();
+
+  for (auto& celkv: workerChargeElectrode) {
+    if (celkv.second) celkv.second->SurfaceTableUpdated();
+  }
+  for (auto& pelkv: workerPhononElectrode) {
+    if (pelkv.second) pelkv.second->SurfaceTableUpdated();
+  }
+}
+
+void G4CMPSurfaceProperty::FillSurfaceData(G4MaterialPropertiesTable& propTab,
+					   G4CMPSurfaceData& data) const {
+  data = G4CMPSurfaceData();
+
+  G4double* field[] = { &data.absProb, &data.reflProb, &data.specProb,
+			&data.absMinK, &data.minKElec, &data.minKHole };
+  const char* key[] = { "absProb", "reflProb", "specProb",
+			"absMinK", "minKElec", "minKHole" };
+
+  for (size_t i=0; i<sizeof(key)/sizeof(key[0]); i++) {
+    if (propTab.ConstPropertyExists(key[i]))
+      *field[i] = propTab.GetConstProperty(key[i]);
+  }
+}
+
+// Tabulate normalized probabilities between cutoffs, where each of the
+// reflection functions is smooth.  Nodes at the lower edge of a segment
+// are evaluated just above the cutoff, consistent with "freq > cutoff".
+// Without specProb the table is left unfilled, and lookups are an error.
+
+void G4CMPSurfaceProperty::FillReflectionTable(G4CMPSurfaceData& data) const {
+  if (!const_cast<G4MaterialPropertiesTable&>(thePhononMatPropTable)
+      .ConstPropertyExists("specProb")) return;
+
+  auto fillProbs = [this](G4double freq, G4double* probs) {
+    probs[G4CMPSurfaceData::kAnharmonic] = AnharmonicReflProb(freq);
+    probs[G4CMPSurfaceData::kSpecular] = SpecularReflProb(freq);
+    probs[G4CMPSurfaceData::kDiffuse] = DiffuseReflProb(freq);
+
+    G4double norm = (probs[0] + probs[1] + probs[2]);
+    if (norm > 0.) {
+      for (G4int i=0; i<G4CMPSurfaceData::kNChannels; i++) probs[i] /= norm;
+    }
+  };
+
+  if (!anharmonicCoeffs.empty() || !diffuseCoeffs.empty() ||
+      !specularCoeffs.empty()) {
+    std::vector<G4double>& edge = data.reflEdge;
+    edge.push_back(0.);
+    if (anharmonicMaxFreq > 0.) edge.push_back(anharmonicMaxFreq);
+    if (diffuseMaxFreq > 0.) edge.push_back(diffuseMaxFreq);
+    std::sort(edge.begin(), edge.end());
+    edge.erase(std::unique(edge.begin(), edge.end()), edge.end());
+
+    size_t nseg = edge.size()-1;
+    data.reflNodes = nReflNodes;
+    data.reflTable.resize(nseg*nReflNodes*G4CMPSurfaceData::kNChannels);
+
+    for (size_t iseg=0; iseg<nseg; iseg++) {
+      G4double lo = edge[iseg], hi = edge[iseg+1];
+      for (G4int j=0; j<nReflNodes; j++) {
+	G4double freq = (j==0 ? (iseg==0 ? lo : std::nextafter(lo, hi))
+			 : lo + (hi-lo)*j/(nReflNodes-1));
+	fillProbs(freq, &data.reflTable[(iseg*nReflNodes+j)
+					*G4CMPSurfaceData::kNChannels]);
+      }
+    }
+  }
+
+  // Above all cutoffs the probabilities do not depend on frequency
+  G4double top = data.reflEdge.empty() ? 0. : data.reflEdge.back();
+  fillProbs(std::nextafter(top, DBL_MAX), data.reflTail);
+
+  data.hasReflection = true;
 }
 
 
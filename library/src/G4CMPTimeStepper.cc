@@ -39,6 +39,14 @@
 //		be delta(E)/(q*V).
 // 20220730  Drop trapping processes, as they have built-in MFPs, and don't
 //		need TimeStepper for energy-dependent calculation.
+// 20261018  Add uniformization (majorant rate with thinning) as alternative
+//		to energy-threshold step limits.
+// 20261018  Fill one G4CMPRateContext per step for both rate models.
+// 20261018  Evaluate majorant at highest energy reachable in step, with
+//		step capped at threshold distance; don't thin above majorant.
+// 20261018  Replace threshold cap with energy window set by majorant scale
+//		from G4CMPConfigManager; majorant failures don't persist.
+// 20261018  Thinning context includes contents needed by both models.
 
 #include "G4CMPTimeStepper.hh"
 #include "G4CMPConfigManager.hh"
@@ -64,11 +72,13 @@
 #include "G4UserLimits.hh"
 #include "G4VParticleChange.hh"
 #include "G4VPhysicalVolume.hh"
+#include "Randomize.hh"
 #include <math.h>
 
 G4CMPTimeStepper::G4CMPTimeStepper()
   : G4CMPVDriftProcess("G4CMPTimeStepper", fTimeStepper), lukeRate(nullptr),
-    ivRate(nullptr) {;}
+    ivRate(nullptr), lukeProc(nullptr), ivProc(nullptr), majorant(0.),
+    windowEnd(false) {;}
 
 G4CMPTimeStepper::~G4CMPTimeStepper() {;}
 
@@ -79,18 +89,16 @@ void G4CMPTimeStepper::LoadDataForTrack(const G4Track* aTrack) {
   G4CMPProcessUtils::LoadDataForTrack(aTrack);	// Common configuration
 
   // Get rate model for Luke phonon emission from process
-  const G4CMPVProcess* lukeProc =
-    dynamic_cast<G4CMPVProcess*>(G4CMP::FindProcess(aTrack,
-						    "G4CMPLukeScattering"));
-  lukeRate = lukeProc ? lukeProc->GetRateModel() : nullptr;
+  lukeProc = G4CMP::FindProcess(aTrack, "G4CMPLukeScattering");
+  const G4CMPVProcess* lukeCMP = dynamic_cast<G4CMPVProcess*>(lukeProc);
+  lukeRate = lukeCMP ? lukeCMP->GetRateModel() : nullptr;
   if (lukeRate)
     const_cast<G4CMPVScatteringRate*>(lukeRate)->LoadDataForTrack(aTrack);
 
   // get rate model for intervalley scattering from process
-  const G4CMPVProcess* ivProc =
-    dynamic_cast<G4CMPVProcess*>(G4CMP::FindProcess(aTrack,
-					    "G4CMPInterValleyScattering"));
-  ivRate = ivProc ? ivProc->GetRateModel() : nullptr;
+  ivProc = G4CMP::FindProcess(aTrack, "G4CMPInterValleyScattering");
+  const G4CMPVProcess* ivCMP = dynamic_cast<G4CMPVProcess*>(ivProc);
+  ivRate = ivCMP ? ivCMP->GetRateModel() : nullptr;
   if (ivRate) 
     const_cast<G4CMPVScatteringRate*>(ivRate)->LoadDataForTrack(aTrack);
 
@@ -107,6 +115,23 @@ void G4CMPTimeStepper::LoadDataForTrack(const G4Track* aTrack) {
 
   if (ivRate && ivRate->GetVerboseLevel() < verboseLevel)
     const_cast<G4CMPVScatteringRate*>(ivRate)->SetVerboseLevel(verboseLevel);
+
+  windowEnd = false;
+}
+
+
+// Select between threshold-limited steps and uniformization
+
+G4double G4CMPTimeStepper::
+PostStepGetPhysicalInteractionLength(const G4Track& aTrack,
+				     G4double prevStepSize,
+				     G4ForceCondition* condition) {
+  if (G4CMPConfigManager::UseUniformization()) {
+    *condition = NotForced;
+    return UniformizedStep(aTrack);
+  }
+
+  return GetMeanFreePath(aTrack, prevStepSize, condition);
 }
 
 
@@ -118,15 +143,18 @@ G4double G4CMPTimeStepper::GetMeanFreePath(const G4Track& aTrack, G4double,
 
   *cond = NotForced;
 
+  // Kinematics for rate calculations, including field
+  const G4CMPRateContext ctx = MakeRateContext(aTrack);
+
   // SPECIAL:  If no electric field, no need to limit steps
-  if (G4CMP::GetFieldAtPosition(aTrack).mag() <= 0.) return DBL_MAX;
+  if (ctx.field.mag() <= 0.) return DBL_MAX;
 
   // Evaluate different step lengths to avoid overrunning process thresholds
   G4double vtrk = GetVelocity(aTrack);
-  G4double ekin = GetKineticEnergy(aTrack);
+  G4double ekin = ctx.energy;
 
   // Get step length due to fastest process
-  G4double rate = MaxRate(aTrack);
+  G4double rate = MaxRate(ctx);
   G4double mfpFast = rate>0. ? vtrk/rate : DBL_MAX;
 
   if (verboseLevel>1) {
@@ -160,7 +188,10 @@ G4double G4CMPTimeStepper::GetMeanFreePath(const G4Track& aTrack, G4double,
 // At end of step, recompute kinematics; important for electrons
 
 G4VParticleChange* G4CMPTimeStepper::PostStepDoIt(const G4Track& aTrack,
-						  const G4Step& /*aStep*/) {
+						  const G4Step& aStep) {
+  if (G4CMPConfigManager::UseUniformization())
+    return ThinningDoIt(aTrack, aStep);
+
   aParticleChange.Initialize(aTrack);
 
   // Adjust mass and kinetic energy using end-of-step momentum
@@ -174,9 +205,9 @@ G4VParticleChange* G4CMPTimeStepper::PostStepDoIt(const G4Track& aTrack,
 
 // Get maximum rate for other processes at given kinematics
 
-G4double G4CMPTimeStepper::MaxRate(const G4Track& aTrack) const {
-  G4double lrate = lukeRate ? lukeRate->Rate(aTrack) : 0.;
-  G4double irate = ivRate ? ivRate->Rate(aTrack) : 0.;
+G4double G4CMPTimeStepper::MaxRate(const G4CMPRateContext& ctx) const {
+  G4double lrate = lukeRate ? lukeRate->Rate(ctx) : 0.;
+  G4double irate = ivRate ? ivRate->Rate(ctx) : 0.;
 
   if (verboseLevel>2) {
     G4cout << "G4CMPTimeStepper::MaxRate luke " << lrate/hertz << " iv "
@@ -193,14 +224,17 @@ G4double G4CMPTimeStepper::DistanceToThreshold(const G4CMPVScatteringRate* rate,
 					       G4double Estart) const {
   if (!rate) return DBL_MAX;		// Skip if no rate model
 
-  // Avoid taking "too short" steps, which causes "stuck tracks"
+  return std::max(EnergyStep(Estart, rate->Threshold(Estart)), MinimumStep());
+}
+
+// Avoid taking "too short" steps, which causes "stuck tracks"
+
+G4double G4CMPTimeStepper::MinimumStep() const {
   G4double MINstep = G4CMPConfigManager::GetMinStepScale();
   MINstep *= (IsElectron() ? theLattice->GetElectronScatter()
 		: theLattice->GetHoleScatter());
 
-  if (MINstep<0) MINstep = 1e-6*m;
-
-  return std::max(EnergyStep(Estart, rate->Threshold(Estart)), MINstep);
+  return (MINstep<0 ? 1e-6*m : MINstep);
 }
 
 // Get step length in E-field needed to reach specified energy
@@ -224,6 +258,127 @@ G4double G4CMPTimeStepper::EnergyStep(G4double Estart, G4double Efinal) const {
 }
 
 
+// Draw step length from majorant rate; memoryless, so each step may redraw.
+// The majorant is held constant over an energy window, from the current
+// energy up to Emax = majorantScale*E.  The carrier can gain at most
+// eplus*|E| per unit length, so the window ends after (Emax-E)/(eplus*|E|),
+// but never less than the minimum step.  A draw beyond the window ends
+// there with no thinning test, and the next step starts a new window.
+// This is exact for piecewise-constant majorants; the scale only trades
+// window-end steps (small scale) against rejected samples (large scale).
+
+G4double G4CMPTimeStepper::UniformizedStep(const G4Track& aTrack) {
+  if (verboseLevel == -1) ReportRates(aTrack);	// SPECIAL FLAG TO REPORT
+
+  const G4CMPRateContext ctx = MakeRateContext(aTrack);
+  G4double vtrk = GetVelocity(aTrack);
+  G4double Emag = ctx.field.mag();
+
+  G4double window = DBL_MAX, Emax = ctx.energy;
+  if (Emag > 0.) {
+    G4double scale = std::max(G4CMPConfigManager::GetMajorantScale(), 1.);
+    window = std::max((scale-1.)*ctx.energy/(eplus*Emag), MinimumStep());
+    Emax = ctx.energy + eplus*Emag*window;
+  }
+
+  majorant = MajorantRate(ctx, Emax);
+
+  G4double step = (majorant > 0. ? -std::log(G4UniformRand())*vtrk/majorant
+		   : DBL_MAX);
+
+  windowEnd = (step > window);
+  if (windowEnd) step = window;
+
+  if (verboseLevel>1) {
+    G4cout << "TS majorant " << majorant/hertz << " Hz at " << Emax/eV
+	   << " eV Vtrk " << vtrk/(m/s) << " m/s step " << step/m << " m"
+	   << (windowEnd ? " (window end)" : "") << G4endl;
+  }
+
+  return step;
+}
+
+// Majorant must bound the total rate over the window, as the carrier is
+// accelerated.  Luke and IV rates rise with energy (Luke with |kHV|, which
+// scales as sqrt(E)), so the rate at Emax bounds every point in the window
+// for which the energy stays below Emax.
+
+G4double G4CMPTimeStepper::MajorantRate(const G4CMPRateContext& ctx,
+					G4double Emax) const {
+  if (Emax <= ctx.energy) return TotalRate(ctx);
+
+  G4CMPRateContext ctxMax = ctx;
+  ctxMax.energy = Emax;
+
+  if (ctx.energy > 0.) {
+    G4double kscale = std::sqrt(Emax/ctx.energy);
+    ctxMax.vLocal *= kscale;
+    ctxMax.kLocal *= kscale;
+    ctxMax.kHV *= kscale;
+  } else {		// Carrier at rest will accelerate along the field
+    G4double mass = (IsElectron() ? theLattice->GetElectronMass()
+		     : theLattice->GetHoleMass());
+    G4ThreeVector kdir = ctx.field.unit() * (IsElectron() ? -1. : 1.);
+    ctxMax.kHV = kdir * std::sqrt(2.*mass*Emax)/hbar_Planck;
+    ctxMax.kLocal = ctxMax.kHV;
+    ctxMax.vLocal = ctxMax.kHV * hbar_Planck/mass;
+  }
+
+  return std::max(TotalRate(ctx), TotalRate(ctxMax));
+}
+
+G4double G4CMPTimeStepper::TotalRate(const G4CMPRateContext& ctx) const {
+  return ((lukeRate ? lukeRate->Rate(ctx) : 0.) +
+	  (ivRate ? ivRate->Rate(ctx) : 0.));
+}
+
+// Thinning test: accept Luke or IV with probability rate/majorant,
+// otherwise take a null ("self-scattering") step with updated kinematics.
+// Steps ending at the energy window are always null steps.
+
+G4VParticleChange* G4CMPTimeStepper::ThinningDoIt(const G4Track& aTrack,
+						  const G4Step& aStep) {
+  ClearNumberOfInteractionLengthLeft();		// All processes must do this!
+
+  const G4CMPRateContext ctx =
+    MakeRateContext(aTrack, ((lukeRate ? lukeRate->GetContextNeeds() : 0) |
+			     (ivRate ? ivRate->GetContextNeeds() : 0)));
+  G4double lrate = (!windowEnd && lukeRate) ? lukeRate->Rate(ctx) : 0.;
+  G4double irate = (!windowEnd && ivRate) ? ivRate->Rate(ctx) : 0.;
+
+  // Majorant failed (e.g., field changed along step): reject the sample as
+  // a null step.  The next step draws a new majorant from the kinematics
+  // here, so nothing carries over to the rest of the track.
+  if (lrate+irate > majorant) {
+    G4ExceptionDescription msg;
+    msg << "Total rate " << (lrate+irate)/hertz << " Hz exceeds majorant "
+	<< majorant/hertz << " Hz; step rejected and redrawn.";
+    G4Exception("G4CMPTimeStepper::ThinningDoIt", "TimeStepper001",
+		JustWarning, msg);
+
+    lrate = irate = 0.;
+  }
+
+  G4double select = G4UniformRand() * majorant;
+  if (verboseLevel>1) {
+    G4cout << "G4CMPTimeStepper::ThinningDoIt luke " << lrate/hertz
+	   << " iv " << irate/hertz << " majorant " << majorant/hertz
+	   << " Hz select " << select/hertz << G4endl;
+  }
+
+  if (lukeProc && select < lrate)
+    return lukeProc->PostStepDoIt(aTrack, aStep);
+
+  if (ivProc && select < lrate+irate)
+    return ivProc->PostStepDoIt(aTrack, aStep);
+
+  // Null step: adjust mass and kinetic energy using end-of-step momentum
+  aParticleChange.Initialize(aTrack);
+  FillParticleChange(GetValleyIndex(aTrack), GetGlobalMomentum(aTrack));
+  return &aParticleChange;
+}
+
+
 // Report Luke and IV rates for diagnostics
 
 void G4CMPTimeStepper::ReportRates(const G4Track& aTrack) {
@@ -0,0 +1,121 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+// $Id$
+//
+// Exact stepper for charge carriers in a uniform electric field.
+//
+// 20261018  New stepper to avoid RK4 integration in uniform fields
+
+#include "G4CMPUniformFieldStepper.hh"
+#include "G4CMPEqEMField.hh"
+#include <algorithm>
+#include <cmath>
+
+
+// Constructor
+
+G4CMPUniformFieldStepper::G4CMPUniformFieldStepper(G4CMPEqEMField* eqMotion,
+						   G4int nvar)
+  : G4MagIntegratorStepper(eqMotion, nvar), theEqMotion(eqMotion),
+    lastSagitta(0.) {
+  std::fill(point, point+4, 0.);
+  std::fill(field, field+6, 0.);
+}
+
+
+// Propagate along parabolic trajectory by path length h
+
+void G4CMPUniformFieldStepper::Stepper(const G4double yIn[],
+				       const G4double /*dydx*/[], G4double h,
+				       G4double yOut[], G4double yErr[]) {
+  G4int nvar = GetNumberOfVariables();
+  std::copy(yIn, yIn+nvar, yOut);
+  std::fill(yErr, yErr+nvar, 0.);
+
+  // Field is uniform, so one evaluation at the start is sufficient
+  std::copy(yIn, yIn+3, point);
+  point[3] = (nvar > 7) ? yIn[7] : 0.;
+  theEqMotion->GetFieldValue(point, field);
+
+  G4ThreeVector accel = theEqMotion->GetAcceleration(field);
+  G4ThreeVector v0 = theEqMotion->GetVelocity(yIn);
+
+  G4double t = TimeForArcLength(v0, accel, h);
+
+  G4ThreeVector dx = t*v0 + (0.5*t*t)*accel;
+  yOut[0] += dx.x();
+  yOut[1] += dx.y();
+  yOut[2] += dx.z();
+  theEqMotion->SetVelocity(v0 + t*accel, yOut);
+  if (nvar > 7) yOut[7] += t;		// Lab time of flight
+
+  // Parabola is farthest from its chord at the parameter midpoint
+  G4ThreeVector dmid = (0.5*t)*v0 + (0.125*t*t)*accel;
+  G4double chord = dx.mag();
+  lastSagitta = (chord > 0.) ? dmid.cross(dx).mag()/chord : 0.;
+}
+
+
+// Path length along trajectory after time t
+
+G4double G4CMPUniformFieldStepper::ArcLength(const G4ThreeVector& v0,
+					     const G4ThreeVector& a,
+					     G4double t) const {
+  G4double amag = a.mag();
+  G4double v0mag = v0.mag();
+
+  // Short steps or weak fields:  Simpson's rule, error O((at/v)^4)
+  if (amag*t < 1e-2*v0mag) {
+    return t*(v0mag + 4.*(v0+(0.5*t)*a).mag() + (v0+t*a).mag()) / 6.;
+  }
+
+  // Speed^2 = vperp^2 + w^2, with w = vpar + |a|t
+  G4double w0 = v0.dot(a)/amag;
+  G4double w1 = w0 + amag*t;
+  G4double vperp2 = std::max(0., v0.mag2() - w0*w0);
+  G4double vperp = std::sqrt(vperp2);
+
+  // Antiderivative of sqrt(w^2 + vperp^2)
+  G4double G0 = 0.5*w0*std::sqrt(w0*w0+vperp2);
+  G4double G1 = 0.5*w1*std::sqrt(w1*w1+vperp2);
+  if (vperp > 0.) {
+    G0 += 0.5*vperp2*std::asinh(w0/vperp);
+    G1 += 0.5*vperp2*std::asinh(w1/vperp);
+  }
+
+  return (G1-G0)/amag;
+}
+
+
+// Invert arc length with Newton's method; ds/dt is the speed
+
+G4double G4CMPUniformFieldStepper::TimeForArcLength(const G4ThreeVector& v0,
+						    const G4ThreeVector& a,
+						    G4double s) const {
+  if (s <= 0.) return 0.;
+
+  G4double amag = a.mag();
+  G4double v0mag = v0.mag();
+  if (amag == 0.) return (v0mag > 0. ? s/v0mag : 0.);
+
+  // Initial guess from whichever of drift or acceleration dominates
+  G4double t = (v0mag > 0.) ? s/v0mag : std::sqrt(2.*s/amag);
+  if (v0mag > 0.) t = std::min(t, v0mag/amag + std::sqrt(2.*s/amag));
+
+  static const G4int maxIter = 20;
+  for (G4int i=0; i<maxIter; i++) {
+    G4double speed = (v0 + t*a).mag();
+    if (speed <= 0.) { t *= 0.5; continue; }	// Stopped; back off
+
+    G4double dt = (ArcLength(v0, a, t) - s) / speed;
+    G4double tnew = t - dt;
+    t = (tnew > 0.) ? tnew : 0.5*t;		// Keep time positive
+
+    if (std::fabs(dt) <= 1e-12*t) break;
+  }
+
+  return t;
+}
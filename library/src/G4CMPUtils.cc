@@ -16,12 +16,18 @@
 // 20190906  M. Kelsey -- Add function to look up process for track
 // 20220816  M. Kelsey -- Move RandomIndex here for more general use
 // 20220921  G4CMP-319 -- Add utilities for thermal (Maxwellian) distributions
+// 20261018  Add LambertReflection for phonon mode, using tabulated envelope
+// 20261018  Take default weights from G4CMPSamplingContext
+// 20261018  LambertReflection falls back to surface normal if not inward
+// 20261018  Move ChargeCarrierTimeStep here, taking lattice as argument
 
 #include "G4CMPUtils.hh"
 #include "G4CMPConfigManager.hh"
 #include "G4CMPDriftElectron.hh"
 #include "G4CMPDriftHole.hh"
 #include "G4CMPElectrodeHit.hh"
+#include "G4CMPLambertianTable.hh"
+#include "G4CMPSamplingContext.hh"
 #include "G4CMPTrackUtils.hh"
 #include "G4LatticePhysical.hh"
 #include "G4ParticleDefinition.hh"
@@ -139,14 +145,14 @@ G4double G4CMP::ChooseWeight(const G4ParticleDefinition* pd,
 }
 
 G4double G4CMP::ChoosePhononWeight(G4double prob) {
-  if (prob < 0.) prob = G4CMPConfigManager::GetGenPhonons();
+  if (prob < 0.) prob = G4CMPSamplingContext::Current().GetGenPhonons();
 
   // If prob=0., random throw always fails, never divides by zero
   return ((prob==1.) ? 1. : (G4UniformRand()<prob) ? 1./prob : 0.);
 }
 
 G4double G4CMP::ChooseChargeWeight(G4double prob) {
-  if (prob < 0.) prob = G4CMPConfigManager::GetGenCharges();
+  if (prob < 0.) prob = G4CMPSamplingContext::Current().GetGenCharges();
 
   // If prob=0., random throw always fails, never divides by zero
   return ((prob==1.) ? 1. : (G4UniformRand()<prob) ? 1./prob : 0.);
@@ -197,6 +203,31 @@ G4ThreeVector G4CMP::LambertReflection(const G4ThreeVector& surfNorm) {
   return refl;
 }
 
+// Sample from table of inward-going region, or throw and test
+
+G4ThreeVector G4CMP::LambertReflection(const G4LatticePhysical* lattice,
+				       G4int mode,
+				       const G4ThreeVector& surfNorm) {
+  const G4CMPLambertianTable* table =
+    G4CMPLambertianTable::GetTable(lattice, mode, surfNorm);
+  if (table) return table->Sample(surfNorm);
+
+  const G4int maxTries = 1000;
+  for (G4int nTries=0; nTries<maxTries; nTries++) {
+    G4ThreeVector reflectedKDir = LambertReflection(surfNorm);
+    if (PhononVelocityIsInward(lattice, mode, reflectedKDir, surfNorm))
+      return reflectedKDir;
+  }
+
+  // Wavevector along -surfNorm always has inward group velocity (v.k > 0)
+  G4ExceptionDescription msg;
+  msg << "No inward direction for mode " << mode << " at " << surfNorm
+      << " after " << maxTries << " tries; using surface normal.";
+  G4Exception("G4CMP::LambertReflection", "Boundary011", JustWarning, msg);
+
+  return -surfNorm;
+}
+
 
 // Check that phonon is properly directed from the volume surface
 
@@ -261,6 +292,18 @@ G4bool G4CMP::IsThermalized(const G4Track* track) {
 }
 
 
+// Compute characteristic time step for charge carrier
+// Parameters are "Mach number" (ratio with sound speed) and scattering length
+
+G4double G4CMP::ChargeCarrierTimeStep(const G4LatticePhysical* lattice,
+				      G4double mach, G4double l0) {
+  const G4double velLong = lattice->GetSoundSpeed();
+
+  const G4double tstep = 3.*l0/velLong;
+  return (mach<1.) ? tstep : tstep*mach/((mach-1)*(mach-1)*(mach-1));
+}
+
+
 // Search particle's processes for specified name
 
 G4VProcess*
@@ -14,6 +14,8 @@
 // 20190906  Bug fix in UseRateModel(), check for good pointer, not null;
 //		Add function to initialize rate model after LoadDataForTrack
 // 20210915  Change diagnostic output to verbose=3 or higher.
+// 20261018  Pass G4CMPRateContext, filled here, to rate model.
+// 20261018  Fill only context contents needed by rate model.
 
 #include "G4CMPVProcess.hh"
 #include "G4CMPConfigManager.hh"
@@ -79,7 +81,10 @@ G4double G4CMPVProcess::GetMeanFreePath(const G4Track& aTrack, G4double,
 					G4ForceCondition* condition) {
   *condition = (rateModel && rateModel->IsForced()) ? Forced : NotForced;
 
-  G4double rate = rateModel ? rateModel->Rate(aTrack) : 0.;
+  G4double rate = 0.;
+  if (rateModel)
+    rate = rateModel->Rate(MakeRateContext(aTrack,
+					     rateModel->GetContextNeeds()));
   G4double vtrk = IsChargeCarrier() ? GetVelocity(aTrack) : aTrack.GetVelocity();
   G4double mfp  = rate>0. ? vtrk/rate : DBL_MAX;
 
@@ -44,6 +44,9 @@
 // 20190906  M. Kelsey -- Default IV rate model to G4CMPConfigManager value.
 // 20200520  For MT thread safety, wrap G4ThreeVector buffer in function to
 //		return thread-local instance.
+// 20261018  Precompute sorted IV thresholds and rate constants in Initialize()
+// 20261018  Refill IV rate constants when IV parameters are set later
+// 20261018  Refill IV rate constants after mass tensor or valley changes
 
 #include "G4LatticeLogical.hh"
 #include "G4CMPPhononKinematics.hh"	// **** THIS BREAKS G4 PORTING ****
@@ -53,6 +56,7 @@
 #include "G4RotationMatrix.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4PhysicalConstants.hh"
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 
@@ -74,7 +78,7 @@ G4LatticeLogical::G4LatticeLogical(const G4String& name)
     fAlpha(0.), fAcDeform(0.), 
     fIVQuadField(0.), fIVQuadRate(0.), fIVQuadExponent(0.),
     fIVLinExponent(0.), fIVLinRate0(0.), fIVLinRate1(0.),
-    fIVModel(G4CMPConfigManager::GetIVRateModel()) {
+    fIVModel(G4CMPConfigManager::GetIVRateModel()), fHasIVRateData(false) {
   for (G4int i=0; i<G4PhononPolarization::NUM_MODES; i++) {
     for (G4int j=0; j<KVBINS; j++) {
       for (G4int k=0; k<KVBINS; k++) {
@@ -147,6 +151,8 @@ G4LatticeLogical& G4LatticeLogical::operator=(const G4LatticeLogical& rhs) {
   fIVLinRate0 = rhs.fIVLinRate0;
   fIVLinRate1 = rhs.fIVLinRate1;
   fIVModel = rhs.fIVModel;
+  fIVRateData = rhs.fIVRateData;
+  fHasIVRateData = rhs.fHasIVRateData;
 
   if (!rhs.fpPhononKin)   fpPhononKin = new G4CMPPhononKinematics(this);
   if (!rhs.fpPhononTable) fpPhononTable = new G4CMPPhononKinTable(fpPhononKin);
@@ -230,6 +236,9 @@ void G4LatticeLogical::Initialize(const G4String& newName) {
 
   // Populate phonon lookup tables if not read from files
   FillMaps();
+
+  // Collect constants used by intervalley rate models
+  FillIVRateData();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -667,6 +676,67 @@ void G4LatticeLogical::FillMassInfo() {
   fMInvRatioSqrt.set(G4Rep3x3(1./fMassRatioSqrt.xx(), 0., 0.,
 			      0., 1./fMassRatioSqrt.yy(), 0.,
 			      0., 0., 1./fMassRatioSqrt.zz()));
+
+  UpdateIVRateData();		// Uses density-of-states mass
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
+
+// Precompute intervalley rate constants, with optical branches sorted by
+// threshold so that rate models may stop at the first closed channel
+
+void G4LatticeLogical::FillIVRateData() {
+  fIVRateData = G4CMPIVRateData();		// Discard any previous values
+
+  G4double mDOS3half = sqrt(fElectronMDOS*fElectronMDOS*fElectronMDOS);
+  G4double hbarSq = hbar_Planck*hbar_Planck;
+
+  // Optical phonon scattering, summed over branches above threshold
+  // FIXME:  Rate should not have 'kT', but leaving it out ruins drift curve
+  G4int nValley = 2*NumberOfValleys()-1;		// From symmetry
+  G4double scale = nValley*/*kT**/mDOS3half / (sqrt(2)*pi*hbarSq*fDensity);
+
+  // Lists may briefly differ in length while being replaced by setters
+  size_t nBranch = std::min(fIVDeform.size(), fIVEnergy.size());
+
+  std::vector<std::pair<G4double,G4double> > branch;	// (E_op, D_op)
+  for (size_t i=0; i<nBranch; i++) {
+    branch.push_back(std::make_pair(fIVEnergy[i], fIVDeform[i]));
+  }
+  std::sort(branch.begin(), branch.end());
+
+  for (size_t i=0; i<branch.size(); i++) {
+    G4double Eop = branch[i].first, Dop = branch[i].second;
+    fIVRateData.threshold.push_back(Eop);
+    fIVRateData.opticalScale.push_back(scale*Dop*Dop/Eop);
+  }
+
+  fIVRateData.alpha = fAlpha;
+
+  // Neutral impurity scattering
+  fIVRateData.impurityScale = 4.*sqrt(2)*fNImpurity*hbarSq / mDOS3half;
+  fIVRateData.impurityEnergy =
+    0.75*eV * (fElectronMDOS/mElectron) / fPermittivity;
+
+  // Field parametrizations, with field units stripped as used by models
+  fIVRateData.linRate0 = fIVLinRate0;
+  fIVRateData.linRate1 = fIVLinRate1;
+  fIVRateData.linExponent = fIVLinExponent;
+
+  G4double E0 = fIVQuadField / (volt/m);
+  fIVRateData.quadRate = fIVQuadRate;
+  fIVRateData.quadField2 = E0*E0;
+  fIVRateData.quadHalfExponent = fIVQuadExponent/2.;
+
+  fHasIVRateData = true;
+
+  if (verboseLevel>1) {
+    G4cout << "G4LatticeLogical::FillIVRateData " << branch.size()
+	   << " optical branches, sorted thresholds";
+    for (size_t i=0; i<branch.size(); i++)
+      G4cout << " " << fIVRateData.threshold[i]/eV;
+    G4cout << " eV" << G4endl;
+  }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -688,6 +758,8 @@ void G4LatticeLogical::AddValley(G4double phi, G4double theta, G4double psi) {
 
   // NOTE:  Rotation matrices take external vector along valley axis to X-hat
   fValleyAxis.push_back(fValleyInv.back()*G4ThreeVector(1.,0.,0.));
+
+  UpdateIVRateData();		// Optical scale uses number of valleys
 }
 
 // Store rotation matrix and corresponding axis vector for valley
@@ -699,6 +771,8 @@ void G4LatticeLogical::AddValley(const G4RotationMatrix& valley) {
 
   // NOTE:  Rotation matrices take external vector along valley axis to X-hat
   fValleyAxis.push_back(fValleyInv.back()*G4ThreeVector(1.,0.,0.));
+
+  UpdateIVRateData();		// Optical scale uses number of valleys
 }
 
 // Transform for drifting-electron valleys in momentum space
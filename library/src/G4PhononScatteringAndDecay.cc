@@ -0,0 +1,234 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+/// \file library/src/G4PhononScatteringAndDecay.cc
+/// \brief Implementation of the G4PhononScatteringAndDecay class
+//
+// 20261018  New process to reduce per-step overhead of separate phonon MFPs
+// 20261018  Use channel rate models; allow channels to be disabled
+
+#include "G4PhononScatteringAndDecay.hh"
+#include "G4CMPAnharmonicDecay.hh"
+#include "G4CMPConfigManager.hh"
+#include "G4CMPDownconversionRate.hh"
+#include "G4CMPPhononScatteringRate.hh"
+#include "G4CMPPhononTrackInfo.hh"
+#include "G4CMPTrackUtils.hh"
+#include "G4CMPUtils.hh"
+#include "G4DynamicParticle.hh"
+#include "G4LatticePhysical.hh"
+#include "G4ParticleChange.hh"
+#include "G4PhononPolarization.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4RandomDirection.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+#include "Randomize.hh"
+#include <algorithm>
+
+
+// Constructor and destructor
+
+G4PhononScatteringAndDecay::G4PhononScatteringAndDecay(const G4String& aName)
+  : G4VPhononProcess(aName, fPhononScatteringAndDecay), totalRate(0.),
+    anharmonicDecay(new G4CMPAnharmonicDecay(this)) {
+  std::fill(channelModel, channelModel+kNChannels, nullptr);
+  std::fill(channelRate, channelRate+kNChannels, 0.);
+
+  UseScatteringRateModel(new G4CMPPhononScatteringRate);
+  UseDownconversionRateModel(new G4CMPDownconversionRate);
+}
+
+G4PhononScatteringAndDecay::~G4PhononScatteringAndDecay() {
+  for (G4int i=0; i<kNChannels; i++) {
+    delete channelModel[i]; channelModel[i]=0;
+  }
+  delete anharmonicDecay;
+}
+
+
+// Register rate model for each channel, replacing any previous version
+
+void G4PhononScatteringAndDecay::
+UseScatteringRateModel(G4CMPVScatteringRate* model) {
+  UseChannelRateModel(kScattering, model);
+}
+
+void G4PhononScatteringAndDecay::
+UseDownconversionRateModel(G4CMPVScatteringRate* model) {
+  UseChannelRateModel(kDownconversion, model);
+}
+
+void G4PhononScatteringAndDecay::
+UseChannelRateModel(G4int channel, G4CMPVScatteringRate* model) {
+  if (model == channelModel[channel]) return;	// Nothing to change
+
+  delete channelModel[channel];			// Avoid memory leaks!
+  channelModel[channel] = model;
+
+  // Ensure that rate models are syncronized with process state
+  ConfigureChannelModels();
+}
+
+void G4PhononScatteringAndDecay::ConfigureChannelModels() {
+  for (G4int i=0; i<kNChannels; i++) {
+    if (!channelModel[i]) continue;
+
+    channelModel[i]->SetVerboseLevel(verboseLevel);
+    if (GetCurrentTrack()) channelModel[i]->LoadDataForTrack(GetCurrentTrack());
+  }
+}
+
+
+// Pass verbosity through to decay utility and rate models
+
+void G4PhononScatteringAndDecay::SetVerboseLevel(G4int vb) {
+  verboseLevel = vb;
+  anharmonicDecay->SetVerboseLevel(vb);
+  ConfigureChannelModels();
+}
+
+
+// Configure decay utility and rate models once per track
+
+void G4PhononScatteringAndDecay::LoadDataForTrack(const G4Track* track) {
+  G4CMPProcessUtils::LoadDataForTrack(track);
+  anharmonicDecay->LoadDataForTrack(track);
+  ConfigureChannelModels();
+}
+
+void G4PhononScatteringAndDecay::EndTracking() {
+  G4CMPVProcess::EndTracking();		// Apply base class actions
+  for (G4int i=0; i<kNChannels; i++) {
+    if (channelModel[i]) channelModel[i]->ReleaseTrack();
+  }
+}
+
+
+// Single MFP from summed rates of enabled channels, each from its model
+
+G4double
+G4PhononScatteringAndDecay::GetMeanFreePath(const G4Track& aTrack, G4double,
+					    G4ForceCondition* condition) {
+  *condition = NotForced;
+
+  // Downconversion model returns zero for transverse phonons, so a track
+  // whose polarization was changed by scattering is handled consistently
+  G4bool enabled[kNChannels];
+  enabled[kScattering] = G4CMPConfigManager::PhononScatteringEnabled();
+  enabled[kDownconversion] = G4CMPConfigManager::PhononDecayEnabled();
+
+  totalRate = 0.;
+  for (G4int i=0; i<kNChannels; i++) {
+    channelRate[i] = ((enabled[i] && channelModel[i])
+		      ? channelModel[i]->Rate(aTrack) : 0.);
+    totalRate += channelRate[i];
+  }
+
+  G4double vtrk = aTrack.GetVelocity();
+  G4double mfp = totalRate>0. ? vtrk/totalRate : DBL_MAX;
+
+  if (verboseLevel>2) {
+    G4cout << GetProcessName() << " scattering "
+	   << channelRate[kScattering]/hertz << " Hz, downconversion "
+	   << channelRate[kDownconversion]/hertz << " Hz"
+	   << " Vtrk = " << vtrk/(m/s) << " m/s"
+	   << " MFP = " << mfp/m << " m" << G4endl;
+  }
+
+  return mfp;
+}
+
+
+// Process actions
+
+G4VParticleChange*
+G4PhononScatteringAndDecay::PostStepDoIt(const G4Track& aTrack,
+					 const G4Step& aStep) {
+  aParticleChange.Initialize(aTrack);
+
+  G4StepPoint* postStepPoint = aStep.GetPostStepPoint();
+  if (postStepPoint->GetStepStatus()==fGeomBoundary ||
+      postStepPoint->GetStepStatus()==fWorldBoundary) {
+    return &aParticleChange;			// Don't want to reset IL
+  }
+
+  if (verboseLevel) G4cout << GetProcessName() << "::PostStepDoIt" << G4endl;
+  if (verboseLevel>1) {
+    G4StepPoint* preStepPoint = aStep.GetPreStepPoint();
+    G4cout << " Track " << aTrack.GetDefinition()->GetParticleName()
+	   << " vol " << aTrack.GetTouchable()->GetVolume()->GetName()
+	   << " prePV " << preStepPoint->GetPhysicalVolume()->GetName()
+	   << " postPV " << postStepPoint->GetPhysicalVolume()->GetName()
+	   << " step-length " << aStep.GetStepLength()
+	   << G4endl;
+  }
+
+  // Select channel by branching fraction; rates are from this step's MFP
+  if (G4UniformRand()*totalRate < channelRate[kDownconversion])
+    return DoDownconversion(aTrack, aStep);
+
+  return DoScattering(aTrack);
+}
+
+
+// Anharmonic decay kills track, so interaction length need not be reset
+
+G4VParticleChange*
+G4PhononScatteringAndDecay::DoDownconversion(const G4Track& aTrack,
+					     const G4Step& aStep) {
+  if (verboseLevel>1) G4cout << " Anharmonic decay in bulk" << G4endl;
+
+  anharmonicDecay->DoDecay(aTrack, aStep, aParticleChange);
+  return &aParticleChange;
+}
+
+
+// Randomly generate a new direction and polarization state
+
+G4VParticleChange*
+G4PhononScatteringAndDecay::DoScattering(const G4Track& aTrack) {
+  G4ThreeVector newK = G4RandomDirection();
+  G4int mode = G4CMP::ChoosePhononPolarization(theLattice->GetLDOS(),
+					       theLattice->GetSTDOS(),
+					       theLattice->GetFTDOS());
+
+  if (verboseLevel>1) {
+    G4cout << " Changing to "
+	   << G4PhononPolarization::Get(mode)->GetParticleName() << " "
+	   << " toward " << newK << G4endl;
+  }
+
+  // Replace track's particle type according to new polarization
+  if (mode != G4PhononPolarization::Get(aTrack.GetParticleDefinition())) {
+    const G4ParticleDefinition* newPD = G4PhononPolarization::Get(mode);
+    auto theDP = const_cast<G4DynamicParticle*>(aTrack.GetDynamicParticle());
+    theDP->SetDefinition(newPD);
+
+    if (verboseLevel>1) {		// Sanity check, report back PD
+      G4cout << " track now " << aTrack.GetDefinition()->GetParticleName()
+	     << G4endl;
+    }
+  }
+
+  // Assign new wave vector direction to track (ought to happen later!)
+  auto trkInfo = G4CMP::GetTrackInfo<G4CMPPhononTrackInfo>(aTrack);
+  trkInfo->SetWaveVector(newK);
+
+  // Set velocity and direction according to new wave vector direction
+  G4double vgrp = theLattice->MapKtoV(mode, newK);
+  G4ThreeVector vdir = theLattice->MapKtoVDir(mode, newK);
+  RotateToGlobalDirection(vdir);
+
+  if (verboseLevel>1)
+    G4cout << " new vgrp " << vgrp << " along " << vdir << G4endl;
+
+  aParticleChange.ProposeMomentumDirection(vdir);
+  aParticleChange.ProposeVelocity(vgrp);
+
+  ClearNumberOfInteractionLengthLeft();		// All processes should do this!
+  return &aParticleChange;
+}
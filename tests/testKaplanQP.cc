@@ -0,0 +1,102 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+// testKaplanQP: Measure per-absorption cost of G4CMPKaplanQP cascade
+//
+// Usage: testKaplanQP [N] [lib]
+//
+// Arguments: N is the number of phonons absorbed at each energy (10000),
+//	      "lib" samples from the precomputed response library instead
+//	      of simulating each cascade.
+//
+// Film parameters are those of the aluminum example in
+// G4CMPPhononElectrode.  Reports the average time per absorption at
+// several incident energies, along with the absorbed fraction and number
+// of re-emitted phonons, and checks energy conservation.
+//
+// 20261018  New benchmark for batched cascade in AbsorbPhonon()
+// 20261018  Save response library explicitly, as a run action would
+
+#include "globals.hh"
+#include "G4CMPKaplanQP.hh"
+#include "G4MaterialPropertiesTable.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Timer.hh"
+#include <numeric>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// Global variables for use in tests
+
+namespace {
+  G4int nErrors = 0;		// Increment counter at failed checks
+}
+
+
+// Absorb N phonons at given energy, report timing and averages
+
+void testAbsorption(G4CMPKaplanQP& kaplan, G4double energy, G4int N) {
+  std::vector<G4double> reflected;
+  reflected.reserve(1000);
+
+  G4double sumDep = 0., sumRefl = 0., sumPhonons = 0.;
+  G4int nBad = 0;
+
+  G4Timer timer;
+  timer.Start();
+  for (G4int i=0; i<N; i++) {
+    reflected.clear();
+    G4double EDep = kaplan.AbsorbPhonon(energy, reflected);
+    G4double ERefl = std::accumulate(reflected.begin(), reflected.end(), 0.);
+
+    sumDep += EDep;
+    sumRefl += ERefl;
+    sumPhonons += reflected.size();
+    if (fabs(energy-EDep-ERefl) > 1e-3*energy) nBad++;
+  }
+  timer.Stop();
+
+  G4cout << " E " << energy/(1e-3*eV) << " meV: "
+	 << timer.GetUserElapsed()/N*1e6 << " us/absorption"
+	 << " absorbed " << sumDep/(N*energy)
+	 << " reflected " << sumRefl/(N*energy)
+	 << " (" << sumPhonons/N << " phonons)" << G4endl;
+
+  if (nBad > 0) {
+    G4cerr << " " << nBad << " absorptions did not conserve energy" << G4endl;
+    nErrors++;
+  }
+}
+
+
+int main(int argc, char* argv[]) {
+  G4int N = (argc>1) ? atoi(argv[1]) : 10000;
+  G4bool useLib = (argc>2 && strcmp(argv[2], "lib")==0);
+
+  // Aluminum film, from G4CMPPhononElectrode example
+  G4MaterialPropertiesTable film;
+  film.AddConstProperty("filmThickness", 600.*nm);
+  film.AddConstProperty("gapEnergy", 173.715e-6*eV);
+  film.AddConstProperty("lowQPLimit", 3.);
+  film.AddConstProperty("phononLifetime", 242.*ps);
+  film.AddConstProperty("phononLifetimeSlope", 0.29);
+  film.AddConstProperty("vSound", 3.26*km/s);
+
+  G4CMPKaplanQP kaplan(&film);
+  kaplan.UseResponseLibrary(useLib);
+
+  G4cout << "G4CMPKaplanQP " << N << " absorptions per energy, "
+	 << (useLib ? "response library" : "full cascade") << G4endl;
+
+  const G4double energies[] = { 0.5, 1., 3., 10., 30., 100. };	// meV
+  for (const G4double& E: energies) {
+    testAbsorption(kaplan, E*1e-3*eV, N);
+  }
+
+  if (useLib) G4CMPKaplanQP::SaveResponseLibraries();	// If cache dir set
+
+  return nErrors;
+}
@@ -0,0 +1,119 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+// Usage: testPresetSampling <Eabs> <Esample> <Lattice> [verbose]
+//
+// Specify absorbed energy (eV), downsampling threshold (eV), and lattice
+// directory.  Geant4 material will be set as "G4_<Lattice>".
+//
+// Partitions energy as G4CMPDriftBoundaryProcess and
+// G4CMPDriftRecombinationProcess do:  phonon sampling is computed first,
+// then DoPartition() is called with downsampling calculations disabled.
+// The generated phonons must carry the computed weight, and the Luke
+// sampling already set for the event must be unchanged.
+//
+// 20261018  New test for preset sampling with downsampling disabled
+
+#include "globals.hh"
+#include "G4CMPConfigManager.hh"
+#include "G4CMPEnergyPartition.hh"
+#include "G4CMPSamplingContext.hh"
+#include "G4CMPUtils.hh"
+#include "G4Delete.hh"
+#include "G4LatticeManager.hh"
+#include "G4LatticePhysical.hh"
+#include "G4LogicalVolume.hh"
+#include "G4NistManager.hh"
+#include "G4PVPlacement.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
+#include "G4Tubs.hh"
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+
+int main(int argc, char* argv[]) {
+  if (argc < 4) {
+    G4cerr << "Usage: " << argv[0] << " <Eabs> <Esamp> <Lattice> [verbose]"
+	   << G4endl << "\tEnergies should be in eV" << G4endl;
+    ::exit(1);
+  }
+
+  G4double Eabs = strtod(argv[1],NULL) * eV;
+  G4double Esamp = strtod(argv[2],NULL) * eV;
+  G4String lname = argv[3];
+  G4String mname = "G4_"+lname;
+
+  G4int verbose = (argc>4) ? atoi(argv[4]) : 0;
+
+  // MUST USE 'new', SO THAT G4SolidStore CAN DELETE
+  G4Material* mat = G4NistManager::Instance()->FindOrBuildMaterial(mname);
+  G4Tubs* crystal = new G4Tubs("GeCrystal", 0., 5.*cm, 1.*cm, 0., 360.*deg);
+  G4LogicalVolume* lv = new G4LogicalVolume(crystal, mat, crystal->GetName());
+  G4PVPlacement* pv = new G4PVPlacement(0, G4ThreeVector(), lv, lv->GetName(),
+					0, false, 1);
+
+  G4LatticePhysical* lattice =
+    G4LatticeManager::Instance()->LoadLattice(pv,lname);
+
+  G4CMPConfigManager::SetSamplingEnergy(Esamp);
+
+  // Event-level Luke sampling, as set by an earlier primary partition
+  const G4double lukeSamp = 0.125;
+  G4CMPSamplingContext::Current().SetLukeSampling(lukeSamp);
+
+  // Same configuration and calls as drift boundary and recombination
+  G4CMPEnergyPartition partition(pv);
+  partition.SetVerboseLevel(verbose);
+  partition.UseDownsampling(false);
+
+  partition.ComputePhononSampling(Eabs);
+  G4double phonSamp = G4CMPSamplingContext::Current().GetGenPhonons();
+
+  partition.DoPartition(0., Eabs);
+
+  std::vector<G4PrimaryParticle*> prim;
+  partition.GetPrimaries(prim);
+
+  // Sampling may be adjusted to give whole number of phonons
+  G4double nTrue = std::ceil(Eabs/lattice->GetDebyeEnergy());
+  G4double nGen = std::round(phonSamp*nTrue);
+  G4double expectWt = (nGen > 0.) ? nTrue/nGen : 0.;
+
+  G4int nPhon = 0, nBad = 0;
+  G4double Ephon = 0.;
+  for (size_t i=0; i<prim.size(); i++) {
+    if (!G4CMP::IsPhonon(prim[i]->GetParticleDefinition())) continue;
+
+    G4double wt = prim[i]->GetWeight();
+    if (fabs(wt-expectWt) > 1e-9*expectWt) nBad++;
+
+    nPhon++;
+    Ephon += prim[i]->GetKineticEnergy() * wt;
+  }
+
+  std::for_each(prim.begin(), prim.end(), Delete<G4PrimaryParticle>());
+  prim.clear();
+
+  G4double lukeAfter = G4CMPSamplingContext::Current().GetLukeSampling();
+
+  G4cout << " Eabs " << Eabs/eV << " eV, sampling " << phonSamp
+	 << "\n " << nPhon << " phonons (" << nTrue << " unsampled) with weight "
+	 << expectWt << ", " << nBad << " wrong; total " << Ephon/eV << " eV"
+	 << "\n Luke sampling " << lukeSamp << " before, " << lukeAfter
+	 << " after" << G4endl;
+
+  G4bool pass = (phonSamp < 1. && nPhon > 0 && nPhon == G4int(nGen) &&
+		 nBad == 0 && expectWt > 1. &&
+		 fabs(Ephon-Eabs) <= 1e-9*Eabs &&
+		 lukeAfter == lukeSamp);
+
+  G4cout << (pass ? "PASS" : "FAIL") << G4endl;
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,261 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+// Usage: testQueuePrimaries <Ehit> <Lattice> [chunk] [verbose]
+//
+// Specify total hit energy (eV), lattice directory, and maximum number
+// of tracks put into the event by G4CMPEnergyPartition::QueuePrimaries()
+// (default 1000).  Geant4 material will be set as "G4_<Lattice>".
+//
+// A single energy deposit is partitioned once, then delivered both by
+// GetPrimaries() (all tracks in event) and QueuePrimaries() (first chunk
+// in event, remainder queued in G4CMPStackingAction).  The two paths must
+// produce the same particle counts and energy sums, with phonons at the
+// deposit position and charges in the charge cloud around it.
+//
+// The queued event is then run through the stacking stages, as Geant4
+// would:  event primaries are pushed (one held on the waiting stack),
+// and each time the urgent stack empties NewStage() pushes the next
+// chunk.  Every queued track must come out, no stage may exceed one
+// chunk, and at most one track may be waiting at a time.
+//
+// 20261018  New test to compare chunked and direct primary delivery
+// 20261018  Check charge cloud placement; run stacking stage loop
+
+#include "globals.hh"
+#include "G4CMPConfigManager.hh"
+#include "G4CMPDriftElectron.hh"
+#include "G4CMPDriftHole.hh"
+#include "G4CMPEnergyPartition.hh"
+#include "G4CMPStackingAction.hh"
+#include "G4CMPUtils.hh"
+#include "G4DynamicParticle.hh"
+#include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4LatticeManager.hh"
+#include "G4LatticePhysical.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Navigator.hh"
+#include "G4NistManager.hh"
+#include "G4PVPlacement.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4PhononPolarization.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4StackManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
+#include "G4Track.hh"
+#include "G4TransportationManager.hh"
+#include "G4Tubs.hh"
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
+
+
+// Accumulate particle counts and weighted energies from either path
+
+struct PartSum {
+  G4int Nchg, Nphon;
+  G4double Echg, Ephon;
+  G4ThreeVector center;		// Phonons here, charges in cloud around it
+  G4bool phononsAtCenter;
+  G4double maxChargeDist;
+
+  PartSum(const G4ThreeVector& pos)
+    : Nchg(0), Nphon(0), Echg(0.), Ephon(0.), center(pos),
+      phononsAtCenter(true), maxChargeDist(0.) {;}
+
+  void Add(const G4ParticleDefinition* pd, G4double E, G4double wt,
+	   const G4ThreeVector& where, G4int n=1) {
+    if (G4CMP::IsPhonon(pd)) {
+      Nphon += n; Ephon += n*E*wt;
+      if (where != center) phononsAtCenter = false;
+    }
+
+    if (G4CMP::IsChargeCarrier(pd)) {
+      Nchg += n; Echg += n*E*wt;
+      maxChargeDist = std::max(maxChargeDist, (where-center).mag());
+    }
+  }
+
+  void Add(const G4Event& evt) {
+    for (G4int iv=0; iv<evt.GetNumberOfPrimaryVertex(); iv++) {
+      const G4PrimaryVertex* vtx = evt.GetPrimaryVertex(iv);
+      for (G4int ip=0; ip<vtx->GetNumberOfParticle(); ip++) {
+	const G4PrimaryParticle* prim = vtx->GetPrimary(ip);
+	Add(prim->GetParticleDefinition(), prim->GetKineticEnergy(),
+	    prim->GetWeight(), vtx->GetPosition());
+      }
+    }
+  }
+};
+
+std::ostream& operator<<(std::ostream& os, const PartSum& sum) {
+  os << sum.Nchg << " e/h " << sum.Echg/keV << " keV within "
+     << sum.maxChargeDist/um << " um, " << sum.Nphon << " phonons "
+     << sum.Ephon/keV << " keV"
+     << (sum.phononsAtCenter ? "" : " (phonons displaced)");
+  return os;
+}
+
+
+// Expose queued vertices, and record stack sizes at each new stage
+
+class TestStacker : public G4CMPStackingAction {
+public:
+  TestStacker() : nStages(0), maxUrgent(0), maxWaiting(0) {;}
+
+  void AddQueued(PartSum& sum) const {
+    for (size_t i=nextQueued; i<queue.size(); i++) {
+      const QueuedVertex& q = queue[i];
+      sum.Add(G4CMPDriftElectron::Definition(), q.eElec, q.chargeWt, q.pos,
+	      q.nElec);
+      sum.Add(G4CMPDriftHole::Definition(), q.eHole, q.chargeWt, q.pos,
+	      q.nHole);
+      sum.Add(G4PhononPolarization::Get(G4PhononPolarization::Long),
+	      q.ePhon, q.phononWt, q.pos, q.nPhon);
+    }
+  }
+
+  size_t GetNumberOfVertices() const { return queue.size() - nextQueued; }
+
+  virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* aTrack) {
+    G4ClassificationOfNewTrack result =
+      G4CMPStackingAction::ClassifyNewTrack(aTrack);
+
+    // Track being classified is not yet on stack
+    maxWaiting = std::max(maxWaiting, stackManager->GetNWaitingTrack()
+			  + (result==fWaiting ? 1 : 0));
+    return result;
+  }
+
+  virtual void NewStage() {
+    G4CMPStackingAction::NewStage();
+    nStages++;
+    maxUrgent = std::max(maxUrgent, stackManager->GetNUrgentTrack());
+  }
+
+  G4int nStages, maxUrgent, maxWaiting;
+};
+
+
+// Main test is here
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    G4cerr << "Usage: " << argv[0] << " <Ehit> <Lattice> [chunk] [verbose]"
+	   << G4endl << "\tEnergy should be in eV" << G4endl;
+    ::exit(1);
+  }
+
+  G4double Ehit = strtod(argv[1],NULL) * eV;
+  G4String lname = argv[2];
+  G4String mname = "G4_"+lname;
+  size_t chunk = (argc>3) ? strtoul(argv[3],NULL,0) : 1000;
+  G4int verbose = (argc>4) ? atoi(argv[4]) : 0;
+
+  // MUST USE 'new', SO THAT G4SolidStore CAN DELETE
+  G4Material* mat = G4NistManager::Instance()->FindOrBuildMaterial(mname);
+  G4Tubs* crystal = new G4Tubs("GeCrystal", 0., 5.*cm, 1.*cm, 0., 360.*deg);
+  G4LogicalVolume* lv = new G4LogicalVolume(crystal, mat, crystal->GetName());
+  G4PVPlacement* pv = new G4PVPlacement(0, G4ThreeVector(), lv, lv->GetName(),
+					0, false, 1);
+
+  // Partitioning looks up touchable at deposit position
+  G4TransportationManager::GetTransportationManager()->
+    GetNavigatorForTracking()->SetWorldVolume(pv);
+
+  G4LatticeManager::Instance()->LoadLattice(pv,lname);
+
+  G4CMPConfigManager::SetSamplingEnergy(-1.);	// Keep every track
+  G4CMPConfigManager::CreateChargeCloud(true);	// Exercise vertex binning
+
+  G4CMPEnergyPartition partition(pv);
+  partition.SetVerboseLevel(verbose);
+  partition.DoPartition(Ehit/2., Ehit/2.);
+
+  // Event manager owns stacking action, and provides stacks for loop below
+  G4EventManager* evtMgr = new G4EventManager;
+  TestStacker* stacker = new TestStacker;
+  stacker->SetChunkSize(chunk);
+  evtMgr->SetUserAction(stacker);
+
+  G4ThreeVector pos(1.*cm, 0., 0.);
+
+  G4Event direct(1);
+  partition.GetPrimaries(&direct, pos, 0.);
+
+  G4Event queued(2);
+  partition.QueuePrimaries(stacker, &queued, pos, 0.);
+
+  PartSum directSum(pos), queuedSum(pos);
+  directSum.Add(direct);
+  queuedSum.Add(queued);
+  stacker->AddQueued(queuedSum);
+
+  size_t nQueued = stacker->GetNumberQueued();
+  G4cout << " Ehit " << Ehit/keV << " keV, " << partition.GetNumberOfTracks()
+	 << " tracks, " << nQueued << " queued at "
+	 << stacker->GetNumberOfVertices() << " positions"
+	 << "\n GetPrimaries   " << directSum
+	 << "\n QueuePrimaries " << queuedSum << G4endl;
+
+  // Charge cloud is microns across; anything near a millimeter is wrong
+  const G4double tol = 1e-9;
+  G4bool pass = (directSum.Nchg == queuedSum.Nchg &&
+		 directSum.Nphon == queuedSum.Nphon &&
+		 fabs(directSum.Echg-queuedSum.Echg) <= tol*directSum.Echg &&
+		 fabs(directSum.Ephon-queuedSum.Ephon) <= tol*directSum.Ephon &&
+		 directSum.phononsAtCenter && queuedSum.phononsAtCenter &&
+		 directSum.maxChargeDist < 1.*mm &&
+		 queuedSum.maxChargeDist < 1.*mm);
+
+  // Stage loop: push event primaries as G4PrimaryTransformer would
+  G4StackManager* stackMgr = evtMgr->GetStackManager();
+  for (G4int iv=0; iv<queued.GetNumberOfPrimaryVertex(); iv++) {
+    const G4PrimaryVertex* vtx = queued.GetPrimaryVertex(iv);
+    for (G4int ip=0; ip<vtx->GetNumberOfParticle(); ip++) {
+      const G4PrimaryParticle* prim = vtx->GetPrimary(ip);
+      G4Track* trk =
+	new G4Track(new G4DynamicParticle(prim->GetParticleDefinition(),
+					  prim->GetMomentumDirection(),
+					  prim->GetKineticEnergy()),
+		    vtx->GetT0(), vtx->GetPosition());
+      trk->SetWeight(prim->GetWeight());
+      trk->SetParentID(0);
+      stackMgr->PushOneTrack(trk);
+    }
+  }
+
+  G4bool holdOne = (nQueued == 0 || stackMgr->GetNWaitingTrack() == 1);
+
+  // Electron energies are adjusted by stacking; compare counts and phonons
+  G4int nTracked = 0, nChg = 0, nPhon = 0;
+  G4double Ephon = 0.;
+  G4VTrajectory* traj = 0;
+  while (G4Track* trk = stackMgr->PopNextTrack(&traj)) {
+    nTracked++;
+    if (G4CMP::IsChargeCarrier(trk)) nChg++;
+    if (G4CMP::IsPhonon(trk)) {
+      nPhon++;
+      Ephon += trk->GetKineticEnergy() * trk->GetWeight();
+    }
+    delete trk;
+  }
+
+  G4cout << " Stage loop: " << nTracked << " tracks in " << stacker->nStages
+	 << " stages, largest stage " << stacker->maxUrgent << ", at most "
+	 << stacker->maxWaiting << " waiting" << G4endl;
+
+  pass &= (holdOne && nTracked == (G4int)partition.GetNumberOfTracks() &&
+	   nChg == directSum.Nchg && nPhon == directSum.Nphon &&
+	   fabs(Ephon-directSum.Ephon) <= tol*directSum.Ephon &&
+	   stacker->maxUrgent <= (G4int)chunk+1 && stacker->maxWaiting <= 1 &&
+	   stacker->GetNumberQueued() == 0);
+
+  G4cout << (pass ? "PASS" : "FAIL") << G4endl;
+  return pass ? 0 : 1;
+}
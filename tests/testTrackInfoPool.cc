@@ -0,0 +1,144 @@
+/***********************************************************************\
+ * This software is licensed under the terms of the GNU General Public *
+ * License version 3 or later. See G4CMP/LICENSE for the full license. *
+\***********************************************************************/
+
+// testTrackInfoPool: Compare allocation cost of phonon track info objects
+//
+// Usage: testTrackInfoPool [N] [loops]
+//
+// Arguments: N is the number of objects live at once (100000), and loops
+//	      the number of times each pattern is repeated (20).
+//
+// Each allocator is timed for two patterns:  "bulk", creating N objects
+// and then deleting them all, as at the end of an event; and "churn",
+// replacing a randomly chosen live object N times, as when tracks are
+// killed and secondaries created during tracking.  Allocators compared
+// are plain malloc (global operator new), a G4Allocator, and the
+// G4CMPTrackInfoPool used by G4CMPPhononTrackInfo::operator new.
+//
+// 20261018  New benchmark for track info pool allocator
+
+#include "globals.hh"
+#include "G4Allocator.hh"
+#include "G4CMPPhononTrackInfo.hh"
+#include "G4ThreeVector.hh"
+#include "G4Timer.hh"
+#include "Randomize.hh"
+#include <new>
+#include <stdlib.h>
+#include <vector>
+
+// Global variables for use in tests
+
+namespace {
+  G4int nErrors = 0;		// Increment counter at failed checks
+
+  const G4ThreeVector kdir(0.,0.,1.);	// Arbitrary wavevector for objects
+}
+
+
+// Allocation strategies, all constructing and destroying the same object
+
+class MallocInfo {
+public:
+  G4CMPPhononTrackInfo* Create() {
+    void* mem = ::operator new(sizeof(G4CMPPhononTrackInfo));
+    return ::new (mem) G4CMPPhononTrackInfo(0, kdir);
+  }
+
+  void Destroy(G4CMPPhononTrackInfo* info) {
+    info->~G4CMPPhononTrackInfo();
+    ::operator delete(static_cast<void*>(info));
+  }
+};
+
+class G4AllocatorInfo {
+public:
+  G4CMPPhononTrackInfo* Create() {
+    return ::new (alloc.MallocSingle()) G4CMPPhononTrackInfo(0, kdir);
+  }
+
+  void Destroy(G4CMPPhononTrackInfo* info) {
+    info->~G4CMPPhononTrackInfo();
+    alloc.FreeSingle(info);
+  }
+
+private:
+  G4Allocator<G4CMPPhononTrackInfo> alloc;
+};
+
+class PoolInfo {
+public:
+  G4CMPPhononTrackInfo* Create() { return new G4CMPPhononTrackInfo(0, kdir); }
+  void Destroy(G4CMPPhononTrackInfo* info) { delete info; }
+};
+
+
+// Time both patterns for given allocator, report ns per object
+
+template <class Alloc>
+void testAllocator(const char* name, Alloc& alloc, G4int N, G4int loops) {
+  std::vector<G4CMPPhononTrackInfo*> live(N, 0);
+
+  G4Timer timer;
+  timer.Start();
+  for (G4int l=0; l<loops; l++) {
+    for (G4int i=0; i<N; i++) live[i] = alloc.Create();
+    for (G4int i=0; i<N; i++) alloc.Destroy(live[i]);
+  }
+  timer.Stop();
+  G4double bulk = timer.GetUserElapsed()/(G4double(N)*loops)*1e9;
+
+  // Pre-generate indices so random numbers aren't included in timing
+  std::vector<G4int> index(N);
+  for (G4int i=0; i<N; i++) index[i] = G4int(G4UniformRand()*N) % N;
+
+  for (G4int i=0; i<N; i++) live[i] = alloc.Create();
+
+  timer.Start();
+  for (G4int l=0; l<loops; l++) {
+    for (G4int i=0; i<N; i++) {
+      alloc.Destroy(live[index[i]]);
+      live[index[i]] = alloc.Create();
+    }
+  }
+  timer.Stop();
+  G4double churn = timer.GetUserElapsed()/(G4double(N)*loops)*1e9;
+
+  for (G4int i=0; i<N; i++) alloc.Destroy(live[i]);
+
+  G4cout << " " << name << ": bulk " << bulk << " ns/object, churn "
+	 << churn << " ns/object" << G4endl;
+}
+
+
+int main(int argc, char* argv[]) {
+  G4int N = (argc>1) ? atoi(argv[1]) : 100000;
+  G4int loops = (argc>2) ? atoi(argv[2]) : 20;
+
+  G4cout << "G4CMPPhononTrackInfo (" << sizeof(G4CMPPhononTrackInfo)
+	 << " bytes) " << N << " objects, " << loops << " loops" << G4endl;
+
+  MallocInfo mallocInfo;
+  testAllocator("malloc     ", mallocInfo, N, loops);
+
+  G4AllocatorInfo g4Info;
+  testAllocator("G4Allocator", g4Info, N, loops);
+
+  PoolInfo poolInfo;
+  testAllocator("pool       ", poolInfo, N, loops);
+
+  // All pool objects should have been returned
+  size_t inUse = G4CMPTrackInfoPool<G4CMPPhononTrackInfo>::GetNumberInUse();
+  if (inUse != 0) {
+    G4cerr << " " << inUse << " pool objects were not freed" << G4endl;
+    nErrors++;
+  }
+
+  G4cout << " pool reserved "
+	 << G4CMPTrackInfoPool<G4CMPPhononTrackInfo>::GetNumberReserved()
+	 << " slots" << G4endl;
+
+  return nErrors;
+}